@@ -49,4 +49,7 @@ macro(find_zlib)
       message(STATUS "ZLIB_LIBRARIES  = '${ZLIB_LIBRARIES}'")
     endif()
   endif()
+
+  # ROSE variables
+  set(ROSE_HAVE_ZLIB ${ZLIB_FOUND})
 endmacro()
@@ -51,6 +51,10 @@ fi
 # The headers must always be present.
 AX_BOOST_SERIALIZATION
 
+# zlib is optional -- used for compressed state files (src/Rose/BinaryAnalysis/SerialIo.h). It must be the same zlib that
+# the Boost iostreams library was compiled against.
+ROSE_SUPPORT_ZLIB
+
 
 dnl  ==================================================================================
 dnl   Check for optional packages that binary analysis in librose can use if available
@@ -81,6 +81,7 @@ AC_DEFUN([ROSE_SUPPORT_SUMMARY],[
 	echo "    z3 version          (SMT solver) ${Z3_VERSION:-unknown}"
 	echo "    z3 executable                    ${Z3:-none}"
 	echo "    z3 library                       ${Z3_LIBRARY_PATH:-none}"
+	echo "    zlib     (compressed state files) ${ROSE_HAVE_ZLIB:-none}"
     fi
 
     #--------------------------------------------------------------------------------
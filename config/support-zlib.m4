@@ -0,0 +1,58 @@
+dnl Tests for zlib.h and libz
+AC_DEFUN([ROSE_SUPPORT_ZLIB],
+[
+    AC_ARG_WITH(
+        [zlib],
+        AS_HELP_STRING(
+            [--with-zlib=PREFIX],
+            [Use the zlib compression library available from https://zlib.net. This optional library is used by binary
+             analysis to read and write compressed state files. It must be the same zlib that Boost's iostreams library
+             was compiled against. The PREFIX, if specified, should be the prefix used to install zlib, such as
+             "/usr/local". The default is the empty prefix, in which case zlib is used if its headers and library are
+             installed in a place where they will be found. Saying "no" for the prefix is the same as saying
+             "--without-zlib".]),
+        [rose_with_zlib="$withval"],
+        [rose_with_zlib=])
+
+    ROSE_HAVE_ZLIB=
+    if test "$rose_with_zlib" = yes -o "$rose_with_zlib" = ""; then
+        # Find zlib in the default location
+        ZLIB_PREFIX=
+        AC_CHECK_HEADER([zlib.h],
+                        [AC_CHECK_LIB(z, deflate,
+                                      [AC_DEFINE(ROSE_HAVE_ZLIB, [], [Defined when zlib is available.])
+                                       ROSE_HAVE_ZLIB=yes
+                                       ZLIB_CPPFLAGS=
+                                       ZLIB_LDFLAGS="-lz"
+                                      ])
+                        ])
+    elif test "$rose_with_zlib" != no; then
+        # Find zlib in the specified location
+        ZLIB_PREFIX="$rose_with_zlib"
+        AC_CHECK_FILE(["$ZLIB_PREFIX/include/zlib.h"],
+                      [AC_CHECK_FILE(["$ZLIB_PREFIX/lib/libz.so"],
+                                     [AC_DEFINE(ROSE_HAVE_ZLIB, [], [Defined when zlib is available.])
+                                      ROSE_HAVE_ZLIB=yes
+                                      ZLIB_CPPFLAGS="-I$ZLIB_PREFIX/include"
+                                      ZLIB_LDFLAGS="-L$ZLIB_PREFIX/lib -lz"
+                                     ])
+                      ])
+    fi
+
+    # Sanity check: if the user told us to use zlib then we must find it
+    if test -n "$rose_with_zlib" -a "$rose_with_zlib" != no -a -z "$ROSE_HAVE_ZLIB"; then
+        AC_MSG_ERROR([did not find zlib but --with-zlib was specified])
+    fi
+
+    # Results:
+    #    ROSE_HAVE_ZLIB    -- shell variable: non-empty when zlib is available
+    #    ROSE_HAVE_ZLIB    -- automake conditional: true when zlib is available
+    #    ROSE_HAVE_ZLIB    -- CPP symbol: defined when zlib is available
+    #    ZLIB_PREFIX       -- automake variable: name of the directory where zlib libraries and headers are installed
+    #    ZLIB_CPPFLAGS     -- automake variable: extra CPP flags needed for using zlib
+    #    ZLIB_LDFLAGS      -- automake variable: extra loader flags to use zlib
+    AM_CONDITIONAL(ROSE_HAVE_ZLIB, [test -n "$ROSE_HAVE_ZLIB"])
+    AC_SUBST(ZLIB_PREFIX)
+    AC_SUBST(ZLIB_CPPFLAGS)
+    AC_SUBST(ZLIB_LDFLAGS)
+])
@@ -76,6 +76,9 @@
 /* Define if libgcrypt is available. */
 #cmakedefine ROSE_HAVE_LIBGCRYPT
 
+/* Define if zlib is available. */
+#cmakedefine ROSE_HAVE_ZLIB
+
 /* Define if YAML-CPP library is available. */
 #cmakedefine ROSE_HAVE_LIBYAML
 
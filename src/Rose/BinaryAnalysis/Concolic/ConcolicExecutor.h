@@ -345,11 +345,16 @@ public:
      *  Executes the test case to produce new test cases. */
     std::vector<TestCasePtr> execute(const DatabasePtr&, const TestCasePtr&);
 
-private:
-    // Disassemble the specimen and cache the result in the database. If the specimen has previously been disassembled
-    // then reconstitute the analysis results from the database.
+    /** Partition a specimen.
+     *
+     *  Disassembles and partitions the specimen and caches the result in the database, or if the specimen has previously
+     *  been partitioned then reconstitutes the result from the database. The specimen must already be in the database.
+     *
+     *  Thread safety: Not thread safe. Partitioning creates AST nodes, which is not thread safe. */
     Partitioner2::Partitioner partition(const DatabasePtr&, const SpecimenPtr&);
 
+private:
+
     // Create the process for the concrete execution.
     ArchitecturePtr makeProcess(const DatabasePtr&, const TestCaseId&, const boost::filesystem::path &tempDir);
 
@@ -48,6 +48,7 @@ private:
     Sawyer::Container::BiMap<ExecutionEventId, ExecutionEventPtr> executionEvents_;
 
     TestSuiteId testSuiteId_;                           // database scope is restricted to this single test suite
+    std::string url_;                                   // how this database was opened
 
 protected:
     Database();
@@ -74,6 +75,26 @@ public:
     }
 #endif
 
+    /** URL used to open or create this database.
+     *
+     *  Another @ref Database object for the same persistent storage can be opened with @ref instance. This is how concurrent
+     *  threads each get their own connection, since a @ref Database object is not thread safe. */
+    const std::string& url() const {
+        return url_;
+    }
+
+    /** Group updates into one transaction.
+     *
+     *  Updates made between @ref beginTransaction and @ref commitTransaction are written to persistent storage all at once,
+     *  which is much faster than writing each update separately, or not at all if @ref rollbackTransaction is called
+     *  instead. Transactions don't nest. Objects memoized by this database are not rolled back.
+     *
+     * @{ */
+    void beginTransaction();
+    void commitTransaction();
+    void rollbackTransaction();
+    /** @} */
+
     /** Create a new database and test suite.
      *
      *  For database management systems that support it, a new database is created, possibly overwriting any previous data if
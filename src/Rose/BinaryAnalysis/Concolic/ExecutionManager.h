@@ -6,6 +6,7 @@
 
 #include <boost/noncopyable.hpp>
 #include <Sawyer/SharedObject.h>
+#include <functional>
 #include <vector>
 
 namespace Rose {
@@ -21,8 +22,12 @@ public:
     /** Reference counting pointer to an @ref ExecutionManager. */
     typedef Sawyer::SharedPointer<ExecutionManager> Ptr;
 
+    /** Creates a concrete executor for one worker thread. */
+    typedef std::function<ConcreteExecutorPtr()> ConcreteExecutorFactory;
+
 private:
     DatabasePtr database_;
+    size_t nWorkers_;                                   // number of test cases executed concurrently, or zero
 
 protected:
     // Subclasses should implement allocating constructors
@@ -36,6 +41,17 @@ public:
      *  The database used by this manager.  The database is set in the constructor and cannot be changed later. */
     DatabasePtr database() const;
 
+    /** Property: Number of test cases executed concurrently.
+     *
+     *  This is the number of worker threads used by @ref runConcretely and the number of child processes used by @ref
+     *  runConcolically. Zero means use the number of threads specified with the "--threads" command-line switch, or the
+     *  hardware concurrency if that's also zero. The default is one.
+     *
+     * @{ */
+    size_t nWorkers() const;
+    void nWorkers(size_t n);
+    /** @} */
+
     /** Next test case for concrete execution.
      *
      *  Returns up to @p n (default unlimited) test cases that need to be run concretely. A test case needs to be run
@@ -80,6 +96,39 @@ public:
      *  Runs concrete and concolic executors until the application is interrupted or there's nothing left to do. Subclasses
      *  will likely reimplement this method in order to do parallel processing, limit execution time, etc. */
     virtual void run() = 0;
+
+protected:
+    /** Number of worker threads to use.
+     *
+     *  This is the @ref nWorkers property with zero resolved as described there. The return value is always positive. */
+    size_t workerPoolSize() const;
+
+    /** Run test cases concretely in parallel.
+     *
+     *  The test cases are executed by a pool of worker threads, each of which uses its own concrete executor created by
+     *  calling the @p factory. The workers don't access the database; instead, once all test cases have run, their results
+     *  are inserted with @ref insertConcreteResults in a single transaction. If any execution throws an exception, the
+     *  results of the other executions are still saved and then the first exception is rethrown. */
+    void runConcretely(const std::vector<TestCaseId>&, const ConcreteExecutorFactory &factory);
+
+    /** Run test cases concolically in parallel.
+     *
+     *  If the worker pool size is one then the test cases are executed one at a time by this thread. Otherwise each test case
+     *  is executed in its own child process, with up to the pool size running at once. Processes are used instead of threads
+     *  because concolic execution creates AST nodes, which is not thread safe. The specimens are partitioned by this process
+     *  before the children are created so that each specimen is partitioned only once. Each child opens its own @ref Database
+     *  object for the same storage and test suite. Once all test cases have run, the test cases modified by the children are
+     *  reloaded and the results are inserted with @ref insertConcolicResults in a single transaction. If any execution fails,
+     *  the results of the other executions are still saved and then an exception is thrown.
+     *
+     *  This function must not be called while this process has other threads, since the children are created with @c
+     *  fork. */
+    void runConcolically(const std::vector<TestCaseId>&);
+
+private:
+    // Insert results for the finished test cases in a single transaction.
+    void saveConcolicResults(const std::vector<TestCaseId>&, const std::vector<std::vector<TestCaseId>> &newTestCaseIds,
+                             const std::vector<char> &finished);
 };
 
 } // namespace
@@ -9,15 +9,24 @@
 #include <boost/serialization/nvp.hpp>
 #include <boost/serialization/base_object.hpp>
 #include <Rose/BinaryAnalysis/Concolic/ConcreteExecutor.h>
+#include <Rose/BinaryAnalysis/Debugger.h>
+#include <boost/filesystem.hpp>
+#include <boost/thread/thread.hpp>
 #include <Sawyer/Optional.h>
 #include <Sawyer/SharedPointer.h>
 #include <string>
+#include <vector>
 
 namespace Rose {
 namespace BinaryAnalysis {
 namespace Concolic {
 
-/** Concrete executor for Linux ELF executables. */
+/** Concrete executor for Linux ELF executables.
+ *
+ *  By default, each test case is executed by running the specimen from scratch. When the @ref forkServer property is set,
+ *  the specimen is instead started once under a @ref Debugger and run to a snapshot point, and each test case is executed by
+ *  forking a new process from that snapshot, which avoids paying the cost of loading, dynamic linking, and any other
+ *  initialization before the snapshot point for every test case. */
 class LinuxExecutor: public ConcreteExecutor {
 public:
     /** Reference counting pointer to a @ref LinuxExecutor. */
@@ -81,6 +90,25 @@ public:
 
 protected:
     bool useAddressRandomization_;                      // enable/disable address space randomization in the OS
+    bool forkServer_;                                   // fork test cases from a snapshot instead of running from scratch
+    Sawyer::Optional<rose_addr_t> forkServerAddress_;   // where to take the snapshot, or the specimen's entry point
+
+    // The fork server's snapshot process and what it was started with. The process is null if no snapshot could be created
+    // for this setup, in which case test cases are executed from scratch. The arguments and environment are only part of the
+    // setup when the snapshot is stopped at a forkServerAddress, since otherwise each test case gets its own.
+    DebuggerPtr snapshot_;                              // process from which test cases are forked
+    SpecimenPtr snapshotSpecimen_;                      // specimen the snapshot is running
+    Sawyer::Optional<rose_addr_t> snapshotAddress_;     // where the snapshot is stopped, or nothing if just after exec
+    std::vector<std::string> snapshotArgs_;             // command-line arguments of a snapshot stopped at an address
+    std::vector<std::string> snapshotEnv_;              // environment of a snapshot stopped at an address
+    Persona snapshotPersona_;                           // personality of the snapshot process
+    boost::filesystem::path snapshotBinary_;            // executable file being run by the snapshot
+    boost::thread::id snapshotThread_;                  // thread that's tracing the snapshot
+
+    // Fork server statistics
+    size_t nSnapshots_;                                 // number of snapshots created
+    size_t nForked_;                                    // number of test cases forked from a snapshot
+    size_t nFromScratch_;                               // number of test cases executed from scratch
 
 protected:
     explicit LinuxExecutor(const DatabasePtr&);
@@ -101,8 +129,78 @@ public:
     void useAddressRandomization(bool b) { useAddressRandomization_ = b; }
     /** @} */
 
+    /** Property: Fork test cases from a snapshot.
+     *
+     *  When set, the first test case starts the specimen under a debugger and keeps that process as a snapshot. Each
+     *  subsequent test case having the same specimen and personality (see @ref useAddressRandomization) is executed by forking
+     *  a new process from the snapshot, giving it the test case's own arguments and environment, and letting it run to
+     *  completion with its output captured as usual. The snapshot is stopped just after the specimen is loaded, before the
+     *  dynamic linker or the program has looked at its arguments or environment, so the test cases need not agree on them.
+     *  If a @ref forkServerAddress is set then the snapshot has already consumed its arguments and environment, so only test
+     *  cases that also have the same arguments and environment share it. A test case that differs replaces the snapshot.
+     *
+     *  Test cases are executed from scratch as if this property were clear when an @ref executionMonitor is used, when no
+     *  snapshot can be created, or when forking fails. Since a traced process can only be controlled by the thread that's
+     *  tracing it, a test case executed by some other thread replaces the snapshot. The fork server uses the same i386 system
+     *  call interface as @ref Debugger::remoteSystemCall. This property is clear by default.
+     *
+     * @{ */
+    bool forkServer() const { return forkServer_; }
+    void forkServer(bool b) { forkServer_ = b; }
+    /** @} */
+
+    /** Property: Where the fork server takes its snapshot.
+     *
+     *  This is the address of the instruction at which the fork server's snapshot is stopped. Test cases start executing at
+     *  this address, which the snapshot reaches by running at full speed to a software breakpoint. Since the snapshot has
+     *  already run with the arguments and environment of the test case that created it, only test cases with the same
+     *  arguments and environment are forked from it. If nothing, then the snapshot is stopped just after the specimen is
+     *  loaded and each forked test case is given its own arguments and environment. Changing this property takes effect when
+     *  the next snapshot is created.
+     *
+     * @{ */
+    Sawyer::Optional<rose_addr_t> forkServerAddress() const { return forkServerAddress_; }
+    void forkServerAddress(const Sawyer::Optional<rose_addr_t> &va) { forkServerAddress_ = va; }
+    /** @} */
+
+    /** Number of fork server snapshots created.
+     *
+     *  This counts the snapshot processes that were loaded, or that reached the @ref forkServerAddress if it's set. */
+    size_t nSnapshots() const { return nSnapshots_; }
+
+    /** Number of test cases forked from a snapshot. */
+    size_t nForked() const { return nForked_; }
+
+    /** Number of test cases executed from scratch.
+     *
+     *  This includes test cases executed while the @ref forkServer property is clear, and those that fell back to being
+     *  executed from scratch. */
+    size_t nFromScratch() const { return nFromScratch_; }
+
+    /** Kill the fork server's snapshot process.
+     *
+     *  The next test case executed with the @ref forkServer property set will create a new snapshot. This is called
+     *  automatically when the executor is destroyed. */
+    void stopForkServer();
+
     virtual
     ConcreteExecutorResult* execute(const TestCasePtr&) ROSE_OVERRIDE;
+
+private:
+    // Kills the snapshot process but remembers what it was running so it isn't recreated for the same test case setup.
+    void killSnapshot();
+
+    // Returns the fork server's snapshot for the test case, creating it if necessary, or null if there is none.
+    DebuggerPtr snapshotFor(const TestCasePtr&, Persona);
+
+    // Replaces the initial stack of a process forked from a snapshot stopped just after exec with one that has the test case's
+    // arguments and environment. Returns false if the stack could not be replaced.
+    bool initializeStack(const DebuggerPtr&, const TestCasePtr&);
+
+    // Executes a test case by forking it from the snapshot. Returns the waitpid status, or nothing if the test case needs
+    // to be executed from scratch instead.
+    Sawyer::Optional<int> executeForked(const TestCasePtr&, Persona, const boost::filesystem::path &logout,
+                                        const boost::filesystem::path &logerr);
 };
 
 } // namespace
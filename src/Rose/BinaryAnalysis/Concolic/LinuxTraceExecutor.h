@@ -5,8 +5,10 @@
 #include <Rose/BinaryAnalysis/Concolic/BasicTypes.h>
 
 #include <Rose/BinaryAnalysis/Concolic/ConcreteExecutor.h>
+#include <Rose/BinaryAnalysis/Partitioner2/BasicTypes.h>
 #include <Sawyer/SharedObject.h>
 #include <Sawyer/SharedPointer.h>
+#include <memory>
 
 namespace Rose {
 namespace BinaryAnalysis {
@@ -14,12 +16,16 @@ namespace Concolic {
 
 /** Concrete executor to trace a native ELF executable.
  *
- *  Ranks executables by the size of the set of addresses that were executed. */
+ *  Ranks executables by the size of the set of addresses that were executed. If the executor was given a partitioner for the
+ *  test case's specimen then the specimen is traced one basic block at a time, otherwise it's traced by single stepping. */
 class LinuxTraceExecutor: public ConcreteExecutor {
 public:
     /** Reference counting pointer to a @ref LinuxTraceExecutor. */
     using Ptr = Sawyer::SharedPointer<LinuxTraceExecutor>;
 
+    /** Shared pointer to a partitioner used for tracing. */
+    using PartitionerPtr = std::shared_ptr<const Partitioner2::Partitioner>;
+
     /** Results of the execution. */
     class Result: public ConcreteExecutorResult {
     public:
@@ -36,14 +42,34 @@ public:
         }
     };
 
+private:
+    SpecimenPtr partitionedSpecimen_;                   // specimen described by partitioner_
+    PartitionerPtr partitioner_;                        // basic blocks used to trace partitionedSpecimen_
+
 protected:
     explicit LinuxTraceExecutor(const DatabasePtr&);
 
 public:
     ~LinuxTraceExecutor();
 
-    /** Allocating constructor. */
+    /** Allocating constructor.
+     *
+     *  The first constructor creates an executor that traces by single stepping. The second creates an executor that traces
+     *  test cases of the specified specimen one basic block at a time using a partitioner created by @ref partition. Since
+     *  the partitioner is only read while tracing, it can be shared by executors that run in different threads.
+     *
+     * @{ */
     static Ptr instance(const DatabasePtr&);
+    static Ptr instance(const DatabasePtr&, const SpecimenPtr&, const PartitionerPtr&);
+    /** @} */
+
+    /** Partition a specimen for tracing.
+     *
+     *  Starts the specimen in a debugger with address randomization disabled and partitions the memory of the new process,
+     *  which is then killed. Partitioning creates AST nodes, which is not thread safe. Therefore this must be called before any
+     *  worker threads are started, such as those used by @ref ExecutionManager::runConcretely, and the resulting partitioner
+     *  is then given to the executors created for those threads. */
+    static PartitionerPtr partition(const SpecimenPtr&);
 
     /** Specimen exit status, as returned by wait. */
     static int exitStatus(const ConcreteExecutorResult*);
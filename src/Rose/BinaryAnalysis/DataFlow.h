@@ -6,15 +6,23 @@
 #include <Rose/BinaryAnalysis/InstructionSemantics2/DataFlowSemantics.h>
 #include <Rose/Diagnostics.h>
 #include <Rose/Exception.h>
+#include <Rose/GraphUtility.h>
 #include <Rose/BinaryAnalysis/InstructionSemantics2/SymbolicSemantics.h>
 
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <exception>
 #include <list>
+#include <set>
 #include <Sawyer/GraphTraversal.h>
 #include <Sawyer/DistinctList.h>
+#include <Sawyer/Graph.h>
+#include <Sawyer/Synchronization.h>
+#include <Sawyer/ThreadWorkers.h>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Rose {
@@ -247,6 +255,15 @@ public:
         }
     };
     
+    /** Order in which the data-flow engine visits vertices.
+     *
+     *  The work list holds the vertices whose incoming states have changed and which therefore need to be visited again. */
+    enum WorkListOrder {
+        WORKLIST_FIFO,                                  /**< Visit vertices in the order they were added to the work list. */
+        WORKLIST_PRIORITY                               /**< Visit strongly connected components in topological order, and the
+                                                         *   vertices within each component in reverse post-order. */
+    };
+
     /** Data-flow engine.
      *
      *  The data-flow engine traverses the supplied control flow graph, runs the transfer function at each vertex, and merges
@@ -303,7 +320,13 @@ public:
      *  InstructionSemantics2::BaseSemantics::State::merge "merge" method.
      *
      *  The control flow graph and transfer function are specified in the engine's constructor.  The starting CFG vertex and
-     *  its initial state are supplied when the engine starts to run. */
+     *  its initial state are supplied when the engine starts to run.
+     *
+     *  By default the work list is first in, first out. Switching the @ref workListOrder to @ref WORKLIST_PRIORITY makes the
+     *  engine finish each loop before it moves on to the code after the loop, and visit each vertex only after its
+     *  predecessors within the loop. Fewer vertices are visited before their incoming states have settled, so the data-flow
+     *  usually reaches a fixed point with fewer calls to the transfer function. With priority order, the engine can also
+     *  solve independent strongly connected components in parallel (see @ref nThreads). */
     template<class CFG, class State, class TransferFunction, class MergeFunction,
              class PathFeasibility = PathAlwaysFeasible<CFG, State> >
     class Engine {
@@ -317,9 +340,17 @@ public:
         VertexStates incomingState_;                    // incoming data-flow state per CFG vertex ID
         VertexStates outgoingState_;                    // outgoing data-flow state per CFG vertex ID
         typedef Sawyer::Container::DistinctList<size_t> WorkList;
-        WorkList workList_;                             // CFG vertex IDs to be visited, last in first out w/out duplicates
+        WorkList workList_;                             // CFG vertex IDs to be visited, first in first out w/out duplicates
+        std::set<size_t> priorityWorkList_;             // vertex priorities to be visited, lowest first (WORKLIST_PRIORITY)
+        WorkListOrder workListOrder_;                   // which of the two work lists is used
+        size_t nThreads_;                               // number of threads for solving components in parallel
+        std::vector<size_t> priority_;                  // vertex priority indexed by vertex ID; empty if not computed yet
+        std::vector<size_t> vertexByPriority_;          // vertex ID indexed by priority
+        std::vector<size_t> component_;                 // strongly connected component number indexed by vertex ID
+        size_t nComponents_;                            // number of strongly connected components
         size_t maxIterations_;                          // max number of iterations to allow
         size_t nIterations_;                            // number of iterations since last reset
+        std::vector<size_t> vertexIterations_;          // number of iterations per vertex since last reset
         PathFeasibility isFeasible_;                    // predicate to test path feasibility
 
     public:
@@ -330,7 +361,8 @@ public:
          *  copied. */
         Engine(const CFG &cfg, TransferFunction &xfer, MergeFunction merge = MergeFunction(),
                PathFeasibility isFeasible = PathFeasibility())
-            : cfg_(cfg), xfer_(xfer), merge_(merge), maxIterations_(-1), nIterations_(0), isFeasible_(isFeasible) {
+            : cfg_(cfg), xfer_(xfer), merge_(merge), workListOrder_(WORKLIST_FIFO), nThreads_(1), nComponents_(0),
+              maxIterations_(-1), nIterations_(0), isFeasible_(isFeasible) {
             reset();
         }
 
@@ -350,9 +382,42 @@ public:
             outgoingState_.clear();
             outgoingState_.resize(cfg_.nVertices(), initialState);
             workList_.clear();
+            priorityWorkList_.clear();
+            priority_.clear();                          // the CFG might have changed, so recompute when needed
             nIterations_ = 0;
+            vertexIterations_.clear();
+            vertexIterations_.resize(cfg_.nVertices(), 0);
         }
 
+        /** Property: Work list order.
+         *
+         *  Determines the order in which vertices are removed from the work list. See @ref WorkListOrder. The order should be
+         *  changed only when the work list is empty, such as right after a @ref reset.
+         *
+         * @{ */
+        WorkListOrder workListOrder() const { return workListOrder_; }
+        void workListOrder(WorkListOrder order) {
+            ASSERT_require(workList_.isEmpty() && priorityWorkList_.empty());
+            workListOrder_ = order;
+        }
+        /** @} */
+
+        /** Property: Number of threads.
+         *
+         *  When the work list order is @ref WORKLIST_PRIORITY and this property is not one, @ref runToFixedPoint solves the
+         *  strongly connected components of the control flow graph in parallel. A component is solved only after all the
+         *  components that can reach it have been solved, so the results are the same as a serial run with priority order.
+         *  Zero means use the hardware concurrency. This has no effect on @ref runOneIteration.
+         *
+         *  The transfer function, merge function, and path feasibility predicate are shared by all threads and are called
+         *  concurrently for vertices in different components, so they must be thread safe. The default is one, which does
+         *  not create any threads.
+         *
+         * @{ */
+        size_t nThreads() const { return nThreads_; }
+        void nThreads(size_t n) { nThreads_ = n; }
+        /** @} */
+
         /** Max number of iterations to allow.
          *
          *  Allow N number of calls to runOneIteration.  When the limit is exceeded a @ref NotConverging exception is
@@ -365,8 +430,16 @@ public:
 
         /** Number of iterations run.
          *
-         *  The number of times runOneIteration was called since the last reset. */
+         *  The number of times runOneIteration was called since the last reset. This is also the number of times the
+         *  transfer function was called. */
         size_t nIterations() const { return nIterations_; }
+
+        /** Number of iterations per vertex.
+         *
+         *  Returns a vector indexed by vertex ID that contains the number of times each vertex was visited since the last
+         *  reset. Vertices that are visited many times are usually loop headers whose incoming states are slow to
+         *  converge. */
+        const std::vector<size_t>& vertexIterations() const { return vertexIterations_; }
         
         /** Runs one iteration.
          *
@@ -374,23 +447,29 @@ public:
          *  work list is empty (before of after the iteration). */
         bool runOneIteration() {
             using namespace Diagnostics;
-            if (!workList_.isEmpty()) {
+            if (!isWorkListEmpty()) {
                 if (++nIterations_ > maxIterations_) {
                     throw NotConverging("data-flow max iterations reached"
                                         " (max=" + StringUtility::numberToString(maxIterations_) + ")");
                 }
-                size_t cfgVertexId = workList_.popFront();
+                size_t cfgVertexId = popWorkList();
                 if (mlog[DEBUG]) {
                     mlog[DEBUG] <<"runOneIteration: vertex #" <<cfgVertexId <<"\n";
                     mlog[DEBUG] <<"  remaining worklist is {";
-                    BOOST_FOREACH (size_t id, workList_.items())
-                        mlog[DEBUG] <<" " <<id;
+                    if (WORKLIST_PRIORITY == workListOrder_) {
+                        BOOST_FOREACH (size_t priority, priorityWorkList_)
+                            mlog[DEBUG] <<" " <<vertexByPriority_[priority];
+                    } else {
+                        BOOST_FOREACH (size_t id, workList_.items())
+                            mlog[DEBUG] <<" " <<id;
+                    }
                     mlog[DEBUG] <<" }\n";
                 }
                 
                 ASSERT_require2(cfgVertexId < cfg_.nVertices(),
                                 "vertex " + boost::lexical_cast<std::string>(cfgVertexId) + " must be valid within CFG");
                 typename CFG::ConstVertexIterator vertex = cfg_.findVertex(cfgVertexId);
+                ++vertexIterations_[cfgVertexId];
                 State state = incomingState_[cfgVertexId];
                 if (mlog[DEBUG]) {
                     mlog[DEBUG] <<"  incoming state for vertex #" <<cfgVertexId <<":\n"
@@ -418,19 +497,19 @@ public:
                                         <<StringUtility::prefixLines(xfer_.toString(incomingState_[nextVertexId]),
                                                                      "      ", false) <<"\n";
                         }
-                        workList_.pushBack(nextVertexId);
+                        pushWorkList(nextVertexId);
                     } else {
                         SAWYER_MESG(mlog[DEBUG]) <<"    merged with vertex #" <<nextVertexId <<" (no change)\n";
                     }
                 }
             }
-            return !workList_.isEmpty();
+            return !isWorkListEmpty();
         }
 
         /** Add a starting vertex. */
         void insertStartingVertex(size_t startVertexId, const State &initialState) {
             incomingState_[startVertexId] = initialState;
-            workList_.pushBack(startVertexId);
+            pushWorkList(startVertexId);
         }
 
         /** Run data-flow until it reaches a fixed point.
@@ -439,7 +518,11 @@ public:
          *  converges to a fixed point or the maximum number of iterations is reached (in which case a @ref NotConverging
          *  exception is thrown). */
         void runToFixedPoint() {
-            while (runOneIteration()) /*void*/;
+            if (WORKLIST_PRIORITY == workListOrder_ && nThreads_ != 1) {
+                runComponentsInParallel();
+            } else {
+                while (runOneIteration()) /*void*/;
+            }
         }
 
         /** Add starting point and run to fixed point.
@@ -448,7 +531,7 @@ public:
         void runToFixedPoint(size_t startVertexId, const State &initialState) {
             reset();
             insertStartingVertex(startVertexId, initialState);
-            while (runOneIteration()) /*void*/;
+            runToFixedPoint();
         }
 
         /** Return the incoming state for the specified CFG vertex.
@@ -487,6 +570,138 @@ public:
         const VertexStates& getFinalStates() const {
             return outgoingState_;
         }
+
+    private:
+        bool isWorkListEmpty() const {
+            return WORKLIST_PRIORITY == workListOrder_ ? priorityWorkList_.empty() : workList_.isEmpty();
+        }
+
+        void pushWorkList(size_t vertexId) {
+            if (WORKLIST_PRIORITY == workListOrder_) {
+                computePriorities(vertexId);
+                priorityWorkList_.insert(priority_[vertexId]);
+            } else {
+                workList_.pushBack(vertexId);
+            }
+        }
+
+        size_t popWorkList() {
+            if (WORKLIST_PRIORITY == workListOrder_) {
+                ASSERT_forbid(priorityWorkList_.empty());
+                size_t priority = *priorityWorkList_.begin();
+                priorityWorkList_.erase(priorityWorkList_.begin());
+                return vertexByPriority_[priority];
+            } else {
+                return workList_.popFront();
+            }
+        }
+
+        // Find the strongly connected components of the CFG (Tarjan's algorithm, without recursion since CFGs can be deep)
+        // and number the vertices so that components are in topological order and vertices within a component are in reverse
+        // post-order. Lower numbers are higher priority. The depth-first search starts at the first vertex added to the work
+        // list, which is normally the starting vertex.
+        void computePriorities(size_t firstVertexId) {
+            if (!priority_.empty() || 0 == cfg_.nVertices())
+                return;
+            const size_t nVertices = cfg_.nVertices();
+            ASSERT_require(firstVertexId < nVertices);
+
+            // After the first vertex, entry vertices (no predecessors) are the preferred roots so that reverse post-order
+            // starts at the top. Components are numbered in topological order.
+            std::vector<size_t> postorder;
+            nComponents_ = GraphUtility::findStronglyConnectedComponents(cfg_, component_, std::vector<size_t>(1, firstVertexId),
+                                                                         &postorder);
+
+            std::vector<std::pair<std::pair<size_t, size_t>, size_t> > keys;
+            keys.reserve(nVertices);
+            for (size_t i = 0; i < nVertices; ++i)
+                keys.push_back(std::make_pair(std::make_pair(component_[i], nVertices - 1 - postorder[i]), i));
+            std::sort(keys.begin(), keys.end());
+            priority_.resize(nVertices);
+            vertexByPriority_.resize(nVertices);
+            for (size_t i = 0; i < nVertices; ++i) {
+                priority_[keys[i].second] = i;
+                vertexByPriority_[i] = keys[i].second;
+            }
+        }
+
+        // Solve each strongly connected component with its own work list, running components in parallel once all the
+        // components that can reach them have been solved.
+        void runComponentsInParallel() {
+            if (priorityWorkList_.empty())
+                return;
+            ASSERT_forbid(priority_.empty());           // computed when the work was added
+
+            // Move the pending work into per-component work lists. Vertex priorities sort by component first.
+            std::vector<std::set<size_t> > pending(nComponents_);
+            BOOST_FOREACH (size_t priority, priorityWorkList_)
+                pending[component_[vertexByPriority_[priority]]].insert(priority);
+            priorityWorkList_.clear();
+
+            // A component depends on each component that has an edge into it.
+            Sawyer::Container::Graph<size_t> dependencies;
+            for (size_t i = 0; i < nComponents_; ++i)
+                dependencies.insertVertex(i);
+            std::set<std::pair<size_t, size_t> > dependencyEdges;
+            BOOST_FOREACH (const typename CFG::Edge &edge, cfg_.edges()) {
+                size_t from = component_[edge.source()->id()], to = component_[edge.target()->id()];
+                if (from != to && dependencyEdges.insert(std::make_pair(to, from)).second)
+                    dependencies.insertEdge(dependencies.findVertex(to), dependencies.findVertex(from));
+            }
+
+            SAWYER_THREAD_TRAITS::Mutex mutex;          // protects pending, nIterations_, exception, and cross-component merges
+            std::exception_ptr exception;
+            Sawyer::workInParallel(dependencies, nThreads_, [this, &mutex, &pending, &exception](size_t, size_t component) {
+                    std::set<size_t> workList;
+                    {
+                        SAWYER_THREAD_TRAITS::LockGuard lock(mutex);
+                        if (exception)
+                            return;
+                        std::swap(workList, pending[component]);
+                    }
+                    try {
+                        while (!workList.empty()) {
+                            size_t cfgVertexId = vertexByPriority_[*workList.begin()];
+                            workList.erase(workList.begin());
+                            {
+                                SAWYER_THREAD_TRAITS::LockGuard lock(mutex);
+                                if (exception)
+                                    return;
+                                if (++nIterations_ > maxIterations_) {
+                                    throw NotConverging("data-flow max iterations reached"
+                                                        " (max=" + StringUtility::numberToString(maxIterations_) + ")");
+                                }
+                            }
+                            ++vertexIterations_[cfgVertexId];
+                            State state = outgoingState_[cfgVertexId] = xfer_(cfg_, cfgVertexId, incomingState_[cfgVertexId]);
+
+                            // Vertices in this component belong to this thread. Vertices in other components haven't started
+                            // yet, but other threads might be merging into them too.
+                            typename CFG::ConstVertexIterator vertex = cfg_.findVertex(cfgVertexId);
+                            BOOST_FOREACH (const typename CFG::Edge &edge, vertex->outEdges()) {
+                                size_t nextVertexId = edge.target()->id();
+                                if (component_[nextVertexId] == component) {
+                                    if (isFeasible_(cfg_, edge, state, incomingState_[nextVertexId]) &&
+                                        merge_(incomingState_[nextVertexId], state))
+                                        workList.insert(priority_[nextVertexId]);
+                                } else {
+                                    SAWYER_THREAD_TRAITS::LockGuard lock(mutex);
+                                    if (isFeasible_(cfg_, edge, state, incomingState_[nextVertexId]) &&
+                                        merge_(incomingState_[nextVertexId], state))
+                                        pending[component_[nextVertexId]].insert(priority_[nextVertexId]);
+                                }
+                            }
+                        }
+                    } catch (...) {
+                        SAWYER_THREAD_TRAITS::LockGuard lock(mutex);
+                        if (!exception)
+                            exception = std::current_exception();
+                    }
+                });
+
+            if (exception)
+                std::rethrow_exception(exception);
+        }
     };
 };
 
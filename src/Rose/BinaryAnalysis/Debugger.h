@@ -9,6 +9,7 @@
 #include <boost/noncopyable.hpp>
 #include <boost/regex.hpp>
 #include <Rose/BinaryAnalysis/Disassembler.h>
+#include <Rose/BinaryAnalysis/Partitioner2/BasicTypes.h>
 #include <Sawyer/BitVector.h>
 #include <Sawyer/Message.h>
 #include <Sawyer/Optional.h>
@@ -233,6 +234,8 @@ public:
 
 private:
     typedef Sawyer::Container::Map<RegisterDescriptor, size_t> UserRegDefs;
+    typedef Sawyer::Container::Map<rose_addr_t, uint8_t> SoftwareBreakpoints;
+    typedef Sawyer::Container::Map<rose_addr_t, std::vector<rose_addr_t> > BlockRuns;
     enum RegPageStatus { REGPAGE_NONE, REGPAGE_REGS, REGPAGE_FPREGS };
 
     Specimen specimen_;                                 // description of specimen being debugged
@@ -240,6 +243,10 @@ private:
     DetachMode autoDetach_;                             // how to detach from the subordinate when deleting this debugger
     int wstat_;                                         // last status from waitpid
     AddressIntervalSet breakpoints_;                    // list of breakpoint addresses
+    SoftwareBreakpoints swBreakpoints_;                 // inserted INT3 instructions and the bytes they replaced
+    BlockRuns blockRuns_;                               // straight-line instructions that can run to a software breakpoint
+    bool tracingForks_;                                 // subordinate reports fork, vfork, clone, and exec events
+    bool swBreakpointsShared_;                          // a thread shares the memory, so software breakpoints can't be used
     int sendSignal_;                                    // pending signal
     UserRegDefs userRegDefs_;                           // how registers map to user_regs_struct in <sys/user.h>
     UserRegDefs userFpRegDefs_;                         // how registers map to user_fpregs_struct in <sys/user.h>
@@ -254,15 +261,15 @@ private:
     //----------------------------------------
 protected:
     Debugger()
-        : child_(0), autoDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageStatus_(REGPAGE_NONE),
-          disassembler_(NULL) {
+        : child_(0), autoDetach_(KILL), wstat_(-1), tracingForks_(false), swBreakpointsShared_(false), sendSignal_(0),
+          kernelWordSize_(0), regsPageStatus_(REGPAGE_NONE), disassembler_(NULL) {
         init();
     }
 
     /** Construct a debugger attached to a specimen. */
     explicit Debugger(const Specimen &specimen)
-        : child_(0), autoDetach_(KILL), wstat_(-1), sendSignal_(0), kernelWordSize_(0), regsPageStatus_(REGPAGE_NONE),
-          disassembler_(NULL) {
+        : child_(0), autoDetach_(KILL), wstat_(-1), tracingForks_(false), swBreakpointsShared_(false), sendSignal_(0),
+          kernelWordSize_(0), regsPageStatus_(REGPAGE_NONE), disassembler_(NULL) {
         init();
         attach(specimen);
     }
@@ -331,7 +338,32 @@ public:
     /** Remove all breakpoints. */
     void clearBreakpoints() { breakpoints_.clear(); }
 
-    /** Execute one instruction. */
+    /** Insert a software breakpoint.
+     *
+     *  Unlike the breakpoints set by @ref setBreakpoint, which are detected by single stepping, a software breakpoint replaces
+     *  the first byte of the instruction at the specified address with an x86 INT3 instruction so that @ref
+     *  runToSoftwareBreakpoint can let the subordinate run at full speed. The replaced byte is restored when the breakpoint is
+     *  removed or the debugger detaches from a process that continues to run, and is hidden from @ref readMemory. The
+     *  breakpoint is not inserted if the byte cannot be read or written. Processes created by @ref remoteFork inherit the
+     *  subordinate's software breakpoints, and writing to the replaced byte with @ref writeMemory removes the breakpoint
+     *  without telling this debugger.
+     *
+     *  While software breakpoints are inserted, processes that the subordinate creates with fork or vfork have the breakpoints
+     *  removed before they run and are then detached, and a vfork parent gets its breakpoints back when the child releases
+     *  the memory. If the subordinate creates a thread, all software breakpoints are removed and no more are inserted, since
+     *  the thread would share them without being debugged; @ref stepBlock then single steps. If the subordinate calls exec,
+     *  the breakpoints are forgotten without being restored since they belonged to the old executable. */
+    void setSoftwareBreakpoint(rose_addr_t va);
+
+    /** Remove a software breakpoint. */
+    void clearSoftwareBreakpoint(rose_addr_t va);
+
+    /** Remove all software breakpoints. */
+    void clearSoftwareBreakpoints();
+
+    /** Execute one instruction.
+     *
+     *  If a software breakpoint is present at the current execution address then the original instruction is executed. */
     void singleStep();
 
     /** Execute to a system call. */
@@ -399,6 +431,28 @@ public:
     /** Run until the next breakpoint is reached. */
     void runToBreakpoint();
 
+    /** Run until the next software breakpoint is reached.
+     *
+     *  The subordinate runs without single stepping until it reaches an address having a software breakpoint, is stopped by a
+     *  signal, or terminates. If a software breakpoint is present at the current execution address then the original
+     *  instruction is executed first. When the subordinate stops at a software breakpoint, the execution address is the
+     *  address of the breakpoint. */
+    void runToSoftwareBreakpoint();
+
+    /** Execute the rest of a basic block.
+     *
+     *  The instructions of the control flow graph's basic block that contains the current execution address are executed
+     *  from that address up to and including the first instruction whose successors are not all known, such as a return or an
+     *  indirect branch. Software breakpoints are inserted at the successors of that instruction, or at the instruction itself
+     *  when its successors are not known, so that the subordinate can run without single stepping. An address that's not in
+     *  the control flow graph, an instruction whose successors are not known, and an instruction at which a signal is to be
+     *  delivered are executed by single stepping. The return value is the list of addresses of the instructions that were
+     *  executed, in the order they were executed, as if they had been single stepped.
+     *
+     *  The breakpoints remain in the subordinate until they are removed with @ref clearSoftwareBreakpoints, after which a
+     *  different partitioner can be used. The partitioner must describe the subordinate's current memory. */
+    std::vector<rose_addr_t> stepBlock(const Partitioner2::Partitioner&);
+
     /** Run until the next system call.
      *
      *  The subordinate is run until it is about to make a system call or has just returned from a system call, or it has
@@ -441,6 +495,36 @@ public:
         return retval;
     }
 
+    /** Run the program and return an execution trace using basic blocks.
+     *
+     *  This produces the same trace as @ref trace without a partitioner, but uses @ref stepBlock to execute the subordinate one
+     *  basic block at a time instead of one instruction at a time, which is much faster. The filter is invoked for each
+     *  instruction after its basic block is executed, therefore when tracing is stopped by the filter the subordinate may have
+     *  executed past the instruction for which it was stopped. All software breakpoints are removed before and after tracing.
+     *
+     * @{ */
+    Sawyer::Container::Trace<rose_addr_t> trace(const Partitioner2::Partitioner&);
+
+    template<class Filter>
+    Sawyer::Container::Trace<rose_addr_t> trace(const Partitioner2::Partitioner &partitioner, Filter &filter) {
+        Sawyer::Container::Trace<rose_addr_t> retval;
+        clearSoftwareBreakpoints();
+        while (!isTerminated()) {
+            for (rose_addr_t va: stepBlock(partitioner)) {
+                FilterAction action = filter(va);
+                if (action.isClear(REJECT))
+                    retval.append(va);
+                if (action.isSet(STOP)) {
+                    clearSoftwareBreakpoints();
+                    return retval;
+                }
+            }
+        }
+        clearSoftwareBreakpoints();
+        return retval;
+    }
+    /** @} */
+
     /** Obtain and cache kernel's word size in bits.  The wordsize of the kernel is not necessarily the same as the word size
      * of the compiled version of this header. */
     size_t kernelWordSize();
@@ -562,6 +646,18 @@ public:
     rose_addr_t remoteMmap(rose_addr_t va, size_t nBytes, unsigned prot, unsigned flags, const boost::filesystem::path&,
                            off_t offset);
 
+    /** Cause the subordinate to fork.
+     *
+     *  The subordinate is coerced into calling @c clone with @c CLONE_PARENT so that the new process is a sibling of the
+     *  subordinate (and thus a child of the calling process) with a copy of the subordinate's memory. The new process is
+     *  automatically traced by the calling thread, is stopped, and has the same registers as the subordinate had before this
+     *  call. Both processes' ptrace options are cleared. Returns the process ID of the new process, or -1 on failure.  The
+     *  new process can be debugged by attaching a new debugger to it with a process @ref Specimen whose @ref ATTACH flag is
+     *  clear, since it's already being traced.
+     *
+     *  Like the other remote system calls, this uses the i386 system call interface. */
+    int remoteFork();
+
 public:
     /**  Initialize diagnostic output. This is called automatically when ROSE is initialized.  */
     static void initDiagnostics();
@@ -584,6 +680,18 @@ private:
     // Address of a system call instruction. The initial search can be expensive, so the result is cached.
     Sawyer::Optional<rose_addr_t> findSystemCall();
 
+    // Write the bytes replaced by software breakpoints into the memory of the specified process.
+    void restoreSoftwareBreakpointBytes(int pid);
+
+    // Deal with a ptrace event stop for a fork, vfork, clone, or exec while software breakpoints are inserted. Returns true if
+    // the subordinate should be resumed as if it hadn't stopped, and false if the stop is something the caller should see.
+    bool handleTraceEvent();
+
+    // Straight-line instructions starting at the specified address that can be executed by running to a software breakpoint.
+    // Inserts the breakpoints where the instructions exit. Returns an empty list if the first instruction must be single
+    // stepped.
+    const std::vector<rose_addr_t>& blockRun(const Partitioner2::Partitioner&, rose_addr_t va);
+
 };
 
 std::ostream& operator<<(std::ostream&, const Debugger::Specimen&);
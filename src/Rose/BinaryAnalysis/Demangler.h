@@ -10,12 +10,24 @@ class Demangler {
 public:
     typedef Sawyer::Container::Map<std::string /*mangled*/, std::string /*non-mangled*/> NameMap;
 
+    /** How names are demangled. */
+    enum Method {
+        METHOD_AUTO,                                    /**< Built-in demangler if it supports the format, else c++filt. */
+        METHOD_BUILTIN,                                 /**< Built-in demangler if available, else c++filt. */
+        METHOD_CXXFILT                                  /**< Always run the c++filt program. */
+    };
+
 private:
     boost::filesystem::path cxxFiltExe_;                // name or path of the c++filt command ($PATH is used to search)
     NameMap nameMap_;                                   // cache of de-mangled names
     std::string compiler_;                              // format of mangled names
+    Method method_;                                     // how to demangle
+    size_t nThreads_;                                   // threads for the built-in demangler; zero means use the global setting
 
 public:
+    Demangler()
+        : method_(METHOD_AUTO), nThreads_(0) {}
+
     /** Property: Name of c++filt program.
      *
      *  This is the name of the c++filt command that gets run to convert mangled names to demangled names. If it's not an
@@ -48,19 +60,61 @@ public:
     void compiler(const std::string &s) { compiler_ = s; }
     /** @} */
 
+    /** Property: Demangling method.
+     *
+     *  The built-in demangler runs in this process and understands the Itanium C++ ABI names used by GCC, LLVM, and most
+     *  other compilers on non-Windows systems. It is much faster than running c++filt, especially for large numbers of names,
+     *  and it demangles in parallel. With the default @ref METHOD_AUTO it's used when the @ref compiler property is empty,
+     *  "auto", or "gnu-v3", and c++filt is used for other formats. Whether the built-in demangler is available at all
+     *  depends on the C++ runtime that ROSE was compiled with; see @ref isBuiltinAvailable.
+     *
+     * @{ */
+    Method method() const { return method_; }
+    void method(Method m) { method_ = m; }
+    /** @} */
+
+    /** Property: Number of threads for the built-in demangler.
+     *
+     *  If zero, then the number of threads comes from the global "--threads" command-line switch, and if that is also zero
+     *  then the hardware concurrency is used. The c++filt method is always single threaded.
+     *
+     * @{ */
+    size_t nThreads() const { return nThreads_; }
+    void nThreads(size_t n) { nThreads_ = n; }
+    /** @} */
+
+    /** Whether the built-in demangler is available. */
+    static bool isBuiltinAvailable();
+
+    /** Whether the built-in demangler will be used.
+     *
+     *  Returns true if @ref fillCache and @ref demangle will use the built-in demangler according to the @ref method and @ref
+     *  compiler properties. */
+    bool usesBuiltin() const;
+
+    /** Demangle one name with the built-in demangler.
+     *
+     *  Returns the demangled name, or the original name if it cannot be demangled or the built-in demangler is not available.
+     *  Symbol version suffixes such as "@@GLIBCXX_3.4" are preserved. Like c++filt, the standard abbreviations such as
+     *  "std::string" are expanded to their full template names. This function doesn't use or modify any cache.
+     *
+     *  Thread safety: This function is thread safe. */
+    static std::string demangleBuiltin(const std::string &mangledName);
+
     /** Demangle lots of names.
      *
-     *  The most efficient way to invoke this analyzer is to provide it with as many names as possible. It will send them all
-     *  to the c++filt program (@ref cxxFiltExe property) all at once and cache the results to query later. */
+     *  The most efficient way to invoke this analyzer is to provide it with as many names as possible. It will demangle them
+     *  all at once, either in parallel with the built-in demangler or by sending them to the c++filt program (@ref cxxFiltExe
+     *  property), and cache the results to query later. See @ref method. */
     void fillCache(const std::vector<std::string> &mangledNames);
 
     /** Demangle one name.
      *
-     *  If the name is already cached, then return the cached value. Otherwise invoke c++filt to demangle this one name and
-     *  cache the result.  A name that cannot be demangled is returned in its original form.
+     *  If the name is already cached, then return the cached value. Otherwise demangle this one name and cache the result. A
+     *  name that cannot be demangled is returned in its original form.
      *
-     *  It is not efficient to fill the cache one name at a time; use @ref fillCache first if possible, and then call this
-     *  function to retrieve the results. */
+     *  When c++filt is used, it is not efficient to fill the cache one name at a time; use @ref fillCache first if possible,
+     *  and then call this function to retrieve the results. */
     std::string demangle(const std::string &mangledName);
 
     /** Clear the cache. */
@@ -76,6 +130,10 @@ public:
      *
      *  Adds (or modifies) the mangled/demangled pair to the cache. */
     void insert(const std::string &mangledName, const std::string &demangledName);
+
+private:
+    void fillCacheBuiltin(const std::vector<std::string> &mangledNames);
+    void fillCacheCxxFilt(const std::vector<std::string> &mangledNames);
 };
 
 } // namespace
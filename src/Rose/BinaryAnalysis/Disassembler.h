@@ -16,6 +16,7 @@
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/string.hpp>
 #include <boost/serialization/version.hpp>
+#include <Sawyer/Optional.h>
 
 // REG_SP possibly defined on __sun
 // REG_LINK possibly defined on Windows
@@ -89,6 +90,28 @@ public:
     /** The InstructionMap is a mapping from (absolute) virtual address to disassembled instruction. */
     typedef Map<rose_addr_t, SgAsmInstruction*> InstructionMap;
 
+    /** Kind of control flow reported by @ref predecode. */
+    enum PredecodedFlow {
+        FLOW_NONE,                                      /**< Falls through to the next instruction. */
+        FLOW_BRANCH,                                    /**< Conditional branch; may also fall through. */
+        FLOW_JUMP,                                      /**< Unconditional jump. */
+        FLOW_CALL,                                      /**< Function call. */
+        FLOW_RETURN,                                    /**< Function return. */
+        FLOW_HALT                                       /**< Stops execution. */
+    };
+
+    /** Result of pre-decoding one instruction.
+     *
+     *  A size of zero means the pre-decoder didn't recognize the instruction and the full disassembler must be used instead. */
+    struct Predecoded {
+        size_t size;                                    /**< Size of the instruction in bytes, or zero. */
+        PredecodedFlow flow;                            /**< Kind of control flow. */
+        Sawyer::Optional<rose_addr_t> target;           /**< Branch, jump, or call target when it's encoded in the instruction. */
+
+        Predecoded()
+            : size(0), flow(FLOW_NONE) {}
+    };
+
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Data members
@@ -331,6 +354,17 @@ public:
     SgAsmInstruction *disassembleOne(const unsigned char *buf, rose_addr_t buf_va, size_t buf_size, rose_addr_t start_va,
                                      AddressSet *successors=NULL);
 
+    /** Decode the size and control flow of one instruction without building an AST.
+     *
+     *  This is much cheaper than @ref disassembleOne and is intended for speculative decoding where most results are thrown
+     *  away. Whenever @ref disassembleOne would return a valid (not "unknown") instruction and this method returns a non-zero
+     *  size, the sizes are equal. This method may return a non-zero size for some byte sequences that the full disassembler
+     *  rejects, and it returns a zero size for anything it doesn't recognize, in which case the caller should fall back to the
+     *  full disassembler. The default implementation recognizes nothing.
+     *
+     *  Thread safety: This method is thread safe as long as no other thread is modifying the memory map. */
+    virtual Predecoded predecode(const MemoryMap::Ptr &map, rose_addr_t va) const;
+
 
     /***************************************************************************************************************************
      *                                          Miscellaneous methods
@@ -116,6 +116,8 @@ public:
     virtual SgAsmInstruction *disassembleOne(const MemoryMap::Ptr &map, rose_addr_t start_va,
                                              AddressSet *successors=NULL) ROSE_OVERRIDE;
 
+    virtual Predecoded predecode(const MemoryMap::Ptr &map, rose_addr_t va) const ROSE_OVERRIDE;
+
     virtual SgAsmInstruction *makeUnknownInstruction(const Exception&) ROSE_OVERRIDE;
 
 
@@ -12,6 +12,7 @@
 #include <Sawyer/Message.h>
 #include <boost/filesystem/path.hpp>
 #include <boost/logic/tribool.hpp>
+#include <boost/shared_ptr.hpp>
 
 namespace Rose {
 namespace BinaryAnalysis {
@@ -42,7 +43,8 @@ public:
     /** Organization of semantic memory. */
     enum SemanticMemoryParadigm {
         LIST_BASED_MEMORY,                              /**< Precise but slow. */
-        MAP_BASED_MEMORY                                /**< Fast but not precise. */
+        MAP_BASED_MEMORY,                               /**< Fast but not precise. */
+        INDEXED_MEMORY                                  /**< Precise like list-based, but indexes concrete addresses. */
     };
 
     /** Edge visitation order. */
@@ -103,6 +105,7 @@ public:
         Sawyer::Optional<boost::chrono::duration<double> > smtTimeout; /**< Max seconds allowed per SMT solve call. */
         size_t maxExprSize;                             /**< Maximum symbolic expression size before replacement. */
         bool traceSemantics;                            /**< Trace all instruction semantics operations. */
+        bool copyOnWrite;                               /**< Share unchanged registers and memory cells between states. */
 
         // Null dereferences
         struct NullDeref {
@@ -123,7 +126,7 @@ public:
               maxRecursionDepth((size_t)-1), nonAddressIsFeasible(true), solverName("best"),
               memoryParadigm(LIST_BASED_MEMORY), processFinalVertex(false), ignoreSemanticFailure(false),
               kCycleCoefficient(0.0), edgeVisitOrder(VISIT_NATURAL), trackingCodeCoverage(true), maxExprSize(UNLIMITED),
-              traceSemantics(false) {}
+              traceSemantics(false), copyOnWrite(false) {}
     };
 
     /** Statistics from path searching. */
@@ -501,6 +504,14 @@ public:
     void functionSummarizer(const FunctionSummarizer::Ptr &f) { functionSummarizer_ = f; }
     /** @} */
 
+    /** Create an analysis for a parallel search.
+     *
+     *  The @ref parallelDepthFirstSearch creates a separate analysis for each starting vertex by calling this function. The
+     *  new analysis must have no search boundary. The default implementation creates a @ref FeasiblePath object with the
+     *  same settings and function summarizer as this analysis. Subclasses that override other processing functions should
+     *  override this function to return an instance of the subclass. */
+    virtual boost::shared_ptr<FeasiblePath> createWorker() const;
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Utilities
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -598,6 +609,36 @@ public:
      *  depth first search, and the search can be limited with various @ref settings. */
     void depthFirstSearch(PathProcessor &pathProcessor);
 
+    /** Find all feasible paths using multiple threads.
+     *
+     *  This is similar to calling @ref setSearchBoundary followed by @ref depthFirstSearch, except each of the @p
+     *  cfgBeginVertices is searched independently by its own analysis obtained from @ref createWorker, and these searches run
+     *  in parallel. Each search has its own paths graph, function summaries, SMT solver, and semantic states, so the only
+     *  things shared between threads are the partitioner, the function summarizer, and the @p pathProcessor. If @p
+     *  cfgEndVertices is supplied then the searches are directed.
+     *
+     *  Calls to the @p pathProcessor are serialized, so the processor need not be thread safe, although the @c analyzer
+     *  argument it receives is the per-vertex analysis rather than this analysis. If any call to the processor's @c found
+     *  method returns @ref PathProcessor::BREAK then no new searches are started, and the searches that are already running
+     *  no longer call the processor and end at their next feasible path. The @ref functionSummarizer, if any, must be thread
+     *  safe. An exception thrown by any search is rethrown here after the other searches end.
+     *
+     *  The number of threads is @p nThreads, or if zero, the number specified by the global "--threads" command-line switch,
+     *  or if that's also zero, the hardware concurrency. When this function returns, this analysis' statistics and function
+     *  summaries are the sums of those from all the searches and the @ref partitioner property is set, but this analysis has
+     *  no paths graph.
+     *
+     * @{ */
+    void parallelDepthFirstSearch(PathProcessor &pathProcessor, const Partitioner2::Partitioner &partitioner,
+                                  const Partitioner2::CfgConstVertexSet &cfgBeginVertices,
+                                  const Partitioner2::CfgConstVertexSet &cfgEndVertices,
+                                  const Partitioner2::CfgConstVertexSet &cfgAvoidVertices = Partitioner2::CfgConstVertexSet(),
+                                  const Partitioner2::CfgConstEdgeSet &cfgAvoidEdges = Partitioner2::CfgConstEdgeSet(),
+                                  size_t nThreads = 0);
+    void parallelDepthFirstSearch(PathProcessor &pathProcessor, const Partitioner2::Partitioner &partitioner,
+                                  const Partitioner2::CfgConstVertexSet &cfgBeginVertices, size_t nThreads = 0);
+    /** @} */
+
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Functions for getting the results
@@ -666,6 +707,13 @@ private:
     // Check that analysis settings are valid, or throw an exception.
     void checkSettings() const;
 
+    // Parallel search, directed if cfgEndVertices is non-null.
+    void parallelSearch(PathProcessor&, const Partitioner2::Partitioner&,
+                        const Partitioner2::CfgConstVertexSet &cfgBeginVertices,
+                        const Partitioner2::CfgConstVertexSet *cfgEndVertices,
+                        const Partitioner2::CfgConstVertexSet &cfgAvoidVertices,
+                        const Partitioner2::CfgConstEdgeSet &cfgAvoidEdges, size_t nThreads);
+
     static rose_addr_t virtualAddress(const Partitioner2::ControlFlowGraph::ConstVertexIterator &vertex);
 
     void insertCallSummary(const Partitioner2::ControlFlowGraph::ConstVertexIterator &pathsCallSite,
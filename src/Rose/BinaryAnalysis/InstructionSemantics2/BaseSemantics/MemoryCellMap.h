@@ -26,7 +26,12 @@ typedef boost::shared_ptr<class MemoryCellMap> MemoryCellMapPtr;
  *  Memory cells (address + value pairs with additional data, @refMemoryCell) are stored in a map-like container so that a cell
  *  can be accessed in logarithmic time given its address.  The keys for the map are generated from the cell virtual addresses,
  *  either by using the address directly or by hashing it. The function that generates these keys, @ref generateCellKey, is
- *  pure virtual. */
+ *  pure virtual.
+ *
+ *  When the @ref copyOnWrite property is set, copying a memory state shares the cells between the original and the copy,
+ *  and a cell is copied only when one of the states accesses it in a way that could modify it. This makes copying a large
+ *  memory state much cheaper in time and space, which is useful for analyses that fork a state at every branch and keep many
+ *  of the copies alive. */
 class MemoryCellMap: public MemoryCellState {
 public:
     /** Key used to look up memory cells.
@@ -42,6 +47,9 @@ public:
 protected:
     CellMap cells;
 
+private:
+    bool copyOnWrite_;                                  // share cells between copies of this state
+
 #ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
 private:
     friend class boost::serialization::access;
@@ -54,18 +62,23 @@ private:
 #endif
     
 protected:
-    MemoryCellMap() {}                                  // for serialization
+    MemoryCellMap()                                     // for serialization
+        : copyOnWrite_(false) {}
 
     explicit MemoryCellMap(const MemoryCellPtr &protocell)
-        : MemoryCellState(protocell) {}
+        : MemoryCellState(protocell), copyOnWrite_(false) {}
 
     MemoryCellMap(const SValuePtr &addrProtoval, const SValuePtr &valProtoval)
-        : MemoryCellState(addrProtoval, valProtoval) {}
+        : MemoryCellState(addrProtoval, valProtoval), copyOnWrite_(false) {}
 
     MemoryCellMap(const MemoryCellMap &other)
-        : MemoryCellState(other) {
-        BOOST_FOREACH (const MemoryCellPtr &cell, other.cells.values())
-            cells.insert(other.generateCellKey(cell->address()), cell->clone());
+        : MemoryCellState(other), copyOnWrite_(other.copyOnWrite_) {
+        if (copyOnWrite_) {
+            cells = other.cells;                        // cells are copied later only if they need to be modified
+        } else {
+            BOOST_FOREACH (const MemoryCellPtr &cell, other.cells.values())
+                cells.insert(other.generateCellKey(cell->address()), cell->clone());
+        }
     }
 
 private:
@@ -85,6 +98,19 @@ public:
     }
 
 public:
+    /** Property: Share cells between copies of this state.
+     *
+     *  When set, copies of this memory state (such as those created by @ref clone) share memory cells with this state and
+     *  with each other, and a cell is copied the first time one of the states reads it or visits it with @ref traverse. The
+     *  setting is inherited by the copies. Cells returned by @ref findCell, @ref matchingCells, and @ref leadingCells might be
+     *  shared with other states and must not be modified. Clearing this property gives this state its own copy of every
+     *  shared cell. The default is to not share cells.
+     *
+     *  @{ */
+    bool copyOnWrite() const { return copyOnWrite_; }
+    void copyOnWrite(bool);
+    /** @} */
+
     /** Generate a cell lookup key.
      *
      *  Generates a key from a virtual address. The key is used to look up the cell in a map-based container. */
@@ -123,6 +149,13 @@ public:
                                        RiscOperators *valOps) ROSE_OVERRIDE;
     virtual AddressSet getWritersIntersection(const SValuePtr &addr, size_t nBits, RiscOperators *addrOps,
                                               RiscOperators *valOps) ROSE_OVERRIDE;
+
+protected:
+    /** Make sure a cell is not shared with another state.
+     *
+     *  If copy-on-write is enabled and the specified cell, which must be a value of the @ref cells map, might be shared
+     *  with some other state, then it's replaced by a copy that belongs only to this state. */
+    void unshareCell(MemoryCellPtr &cell);
 };
 
 } // namespace
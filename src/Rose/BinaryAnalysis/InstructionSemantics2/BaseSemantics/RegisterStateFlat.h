@@ -0,0 +1,227 @@
+#ifndef ROSE_BinaryAnalysis_InstructionSemantics2_BaseSemantics_RegisterStateFlat_H
+#define ROSE_BinaryAnalysis_InstructionSemantics2_BaseSemantics_RegisterStateFlat_H
+#include <featureTests.h>
+#ifdef ROSE_ENABLE_BINARY_ANALYSIS
+
+#include <Rose/BinaryAnalysis/InstructionSemantics2/BaseSemantics/RegisterStateGeneric.h>
+
+#ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
+#include <boost/serialization/split_member.hpp>
+#endif
+
+#include <vector>
+
+namespace Rose {
+namespace BinaryAnalysis {
+namespace InstructionSemantics2 {
+namespace BaseSemantics {
+
+/** Shared-ownership pointer to flat register states. See @ref heap_object_shared_ownership. */
+typedef boost::shared_ptr<class RegisterStateFlat> RegisterStateFlatPtr;
+
+/** A register state whose layout is computed from the register dictionary.
+ *
+ *  This is a @ref RegisterStateGeneric that finds each register's storage through a table built once from the register
+ *  dictionary instead of searching the register map, and that keeps each hardware register (each major/minor pair) as a
+ *  single value spanning all the bits that the dictionary defines for it. Reading or writing a whole hardware register, such
+ *  as x86 RAX or EFLAGS, just returns or replaces that value. Reading part of a register, such as AL, extracts the bits from
+ *  the stored value, and writing part of a register concatenates the new bits with the stored bits, instead of splitting the
+ *  storage into pieces as @ref RegisterStateGeneric does. Accesses that can't be handled this way, such as the first access to
+ *  only part of a register, or registers that are not in the dictionary, are handled by @ref RegisterStateGeneric and produce
+ *  the same values.
+ *
+ *  Since it's a @ref RegisterStateGeneric, this state can be used anywhere the generic state can, including as the register
+ *  state for @ref SymbolicSemantics and @ref ConcreteSemantics, and it supports the same writer and property tracking,
+ *  traversals, merging, and printing:
+ *
+ * @code
+ *  BaseSemantics::SValuePtr protoval = ConcreteSemantics::SValue::instance();
+ *  BaseSemantics::RegisterStatePtr registers = BaseSemantics::RegisterStateFlat::instance(protoval, regdict);
+ *  BaseSemantics::MemoryStatePtr memory = ConcreteSemantics::MemoryState::instance(protoval, protoval);
+ *  BaseSemantics::StatePtr state = ConcreteSemantics::State::instance(registers, memory);
+ *  BaseSemantics::RiscOperatorsPtr ops = ConcreteSemantics::RiscOperators::instance(state);
+ * @endcode
+ *
+ *  Subclasses must not remove entries from the inherited @ref registers_ map except through @ref clear. */
+class RegisterStateFlat: public RegisterStateGeneric {
+public:
+    /** Storage layout for the registers of a dictionary.
+     *
+     *  The layout assigns a slot to each major/minor pair defined by the dictionary and records the bits spanned by all the
+     *  dictionary's registers having that pair. Layouts are immutable and shared by all states created from one another. */
+    class Layout {
+        std::vector<size_t> firstSlot_;                 // slot index of minor number zero for each major number
+        std::vector<size_t> nMinors_;                   // number of minor numbers for each major number
+        std::vector<BitRange> locations_;               // bits defined by the dictionary for each slot, or empty
+
+    public:
+        /** Compute the layout for a dictionary. */
+        explicit Layout(const RegisterDictionary*);
+
+        /** Number of slots. */
+        size_t nSlots() const { return locations_.size(); }
+
+        /** Slot for a register.
+         *
+         *  Returns the slot for the register's major/minor pair if the dictionary defines registers for that pair and all
+         *  bits of the specified register fall within them. */
+        Sawyer::Optional<size_t> slot(RegisterDescriptor reg) const {
+            if (reg.majorNumber() >= firstSlot_.size() || reg.minorNumber() >= nMinors_[reg.majorNumber()])
+                return Sawyer::Nothing();
+            size_t idx = firstSlot_[reg.majorNumber()] + reg.minorNumber();
+            const BitRange &where = locations_[idx];
+            if (where.isEmpty() || reg.offset() < where.least() || reg.offset() + reg.nBits() > where.greatest() + 1)
+                return Sawyer::Nothing();
+            return idx;
+        }
+
+        /** Bits defined by the dictionary for a slot. */
+        const BitRange& location(size_t slot) const {
+            ASSERT_require(slot < locations_.size());
+            return locations_[slot];
+        }
+    };
+
+    /** Shared-ownership pointer to a layout. */
+    typedef boost::shared_ptr<const Layout> LayoutPtr;
+
+private:
+    LayoutPtr layout_;
+    std::vector<RegPairs*> slots_;                      // storage for each slot in registers_, or null if not looked up yet
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Serialization
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
+private:
+    friend class boost::serialization::access;
+
+    // The layout and slots are not saved. Loading replaces every node of the register map, so the layout is recomputed from
+    // the register dictionary and the slots are looked up again as they're needed.
+    template<class S>
+    void save(S &s, const unsigned /*version*/) const {
+        s & BOOST_SERIALIZATION_BASE_OBJECT_NVP(RegisterStateGeneric);
+    }
+
+    template<class S>
+    void load(S &s, const unsigned /*version*/) {
+        s & BOOST_SERIALIZATION_BASE_OBJECT_NVP(RegisterStateGeneric);
+        ASSERT_not_null(registerDictionary());
+        layout_ = LayoutPtr(new Layout(registerDictionary()));
+        slots_.assign(layout_->nSlots(), nullptr);
+    }
+
+    BOOST_SERIALIZATION_SPLIT_MEMBER();
+#endif
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Normal constructors
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+protected:
+    RegisterStateFlat() {}                              // for serialization
+
+    RegisterStateFlat(const SValuePtr &protoval, const RegisterDictionary *regdict, const LayoutPtr &layout)
+        : RegisterStateGeneric(protoval, regdict), layout_(layout), slots_(layout->nSlots(), nullptr) {}
+
+    RegisterStateFlat(const RegisterStateFlat &other)
+        : RegisterStateGeneric(other), layout_(other.layout_), slots_(other.slots_.size(), nullptr) {}
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Static allocating constructors
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+    /** Instantiate a new register state.
+     *
+     *  The layout is computed from the register dictionary, which must not be null. */
+    static RegisterStateFlatPtr instance(const SValuePtr &protoval, const RegisterDictionary *regdict) {
+        ASSERT_not_null(regdict);
+        return RegisterStateFlatPtr(new RegisterStateFlat(protoval, regdict, LayoutPtr(new Layout(regdict))));
+    }
+
+    /** Instantiate a new copy of an existing register state. */
+    static RegisterStateFlatPtr instance(const RegisterStateFlatPtr &other) {
+        return RegisterStateFlatPtr(new RegisterStateFlat(*other));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Virtual constructors
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+    virtual RegisterStatePtr create(const SValuePtr &protoval, const RegisterDictionary *regdict) const override {
+        if (regdict == registerDictionary())
+            return RegisterStateFlatPtr(new RegisterStateFlat(protoval, regdict, layout_));
+        return instance(protoval, regdict);
+    }
+
+    virtual RegisterStatePtr clone() const override {
+        return RegisterStateFlatPtr(new RegisterStateFlat(*this));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Dynamic pointer casts
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+    /** Run-time promotion of a base register state pointer to a RegisterStateFlat pointer. This is a checked conversion--it
+     *  will fail if @p from does not point to a RegisterStateFlat object. */
+    static RegisterStateFlatPtr promote(const RegisterStatePtr &from) {
+        RegisterStateFlatPtr retval = boost::dynamic_pointer_cast<RegisterStateFlat>(from);
+        ASSERT_not_null(retval);
+        return retval;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Object properties
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+    /** Property: Storage layout.
+     *
+     *  This is the layout computed from the register dictionary when the state was created. */
+    LayoutPtr layout() const { return layout_; }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Inherited non-constructors
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+public:
+    virtual void clear() override;
+    virtual SValuePtr readRegister(RegisterDescriptor, const SValuePtr &dflt, RiscOperators*) override;
+    virtual SValuePtr peekRegister(RegisterDescriptor, const SValuePtr &dflt, RiscOperators*) override;
+    virtual void writeRegister(RegisterDescriptor, const SValuePtr &value, RiscOperators*) override;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //                                  Non-public APIs
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+private:
+    // Storage for a slot, inserting an empty list into the register map if necessary.
+    RegPairs& storage(size_t slot, RegisterDescriptor reg) {
+        RegPairs *&pairs = slots_[slot];
+        if (!pairs)
+            pairs = &registers_.insertMaybeDefault(reg);
+        return *pairs;
+    }
+
+    // Storage for a slot without inserting anything into the register map, or null if the map has no entry for it.
+    RegPairs* findStorage(size_t slot, RegisterDescriptor reg) {
+        RegPairs *&pairs = slots_[slot];
+        if (!pairs) {
+            Registers::NodeIterator found = registers_.find(reg);
+            if (found != registers_.nodes().end())
+                pairs = &found->value();
+        }
+        return pairs;
+    }
+
+    // The stored value if the slot is stored as a single value spanning all its bits, otherwise null.
+    SValuePtr wholeValue(size_t slot, const RegPairs*) const;
+};
+
+} // namespace
+} // namespace
+} // namespace
+} // namespace
+
+#ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
+BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::InstructionSemantics2::BaseSemantics::RegisterStateFlat);
+#endif
+
+#endif
+#endif
@@ -36,7 +36,9 @@ typedef boost::shared_ptr<class RegisterStateGeneric> RegisterStateGenericPtr;
  *  doesn't update this information automatically--it only provides the API by which a higher software layer can manipulate the
  *  information.  This design allows the writer data structure to alternatively be used for things other than addresses of
  *  writing instructions.  For instance, the @ref SymbolicSemantics::RiscOperators has a setting that enables tracking
- *  writers. */
+ *  writers.
+ *
+ *  When the @ref copyOnWrite property is set, copies of the state share register values instead of copying them. */
 class RegisterStateGeneric: public RegisterState {
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Basic Types
@@ -161,6 +163,7 @@ private:
     RegisterAddressSet writers_;                        // Writing instruction address set for each bit of each register
     bool accessModifiesExistingLocations_;              // Can read/write modify existing locations?
     bool accessCreatesLocations_;                       // Can new locations be created?
+    bool copyOnWrite_;                                  // Are values shared between copies of this state?
 
 protected:
     /** Values for registers that have been accessed.
@@ -198,18 +201,21 @@ private:
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 protected:
     RegisterStateGeneric()                              // for serialization
-        : accessModifiesExistingLocations_(true), accessCreatesLocations_(true) {}
+        : accessModifiesExistingLocations_(true), accessCreatesLocations_(true), copyOnWrite_(false) {}
 
     explicit RegisterStateGeneric(const SValuePtr &protoval, const RegisterDictionary *regdict)
-        : RegisterState(protoval, regdict), accessModifiesExistingLocations_(true), accessCreatesLocations_(true) {
+        : RegisterState(protoval, regdict), accessModifiesExistingLocations_(true), accessCreatesLocations_(true),
+          copyOnWrite_(false) {
         clear();
     }
 
     RegisterStateGeneric(const RegisterStateGeneric &other)
         : RegisterState(other), properties_(other.properties_), writers_(other.writers_),
           accessModifiesExistingLocations_(other.accessModifiesExistingLocations_),
-          accessCreatesLocations_(other.accessCreatesLocations_), registers_(other.registers_) {
-        deep_copy_values();
+          accessCreatesLocations_(other.accessCreatesLocations_), copyOnWrite_(other.copyOnWrite_),
+          registers_(other.registers_) {
+        if (!copyOnWrite_)
+            deep_copy_values();
     }
 
 
@@ -308,6 +314,20 @@ public:
     virtual void accessCreatesLocations(bool b) { accessCreatesLocations_ = b; }
     /** @} */
 
+    /** Property: Share values between copies of this state.
+     *
+     *  When set, copies of this register state (such as those created by @ref clone) share their register values with this
+     *  state instead of copying them. Shared values are never modified: @ref readRegister and @ref peekRegister return
+     *  copies that the caller may modify without affecting the state, and @ref traverse gives each value its own copy before
+     *  visiting it. The values returned by @ref get_stored_registers might be shared and must not be modified. The setting
+     *  is inherited by copies. Clearing the property gives this state its own copy of every value. The default is to not
+     *  share values.
+     *
+     * @{ */
+    bool copyOnWrite() const /*final*/ { return copyOnWrite_; }
+    virtual void copyOnWrite(bool);
+    /** @} */
+
     /** Guards whether access is able to create new locations.
      *
      *  This guard temporarily enables or disables the @ref accessCreatesLocations property, restoring the property to its
@@ -12,8 +12,14 @@
 #include <Rose/BinaryAnalysis/InstructionSemantics2/BaseSemantics.h>
 #include <Sawyer/BitVector.h>
 
+#include <map>
+#include <set>
+#include <vector>
+
 namespace Rose {
 namespace BinaryAnalysis {              // documented elsewhere
+
+class Disassembler;
 namespace InstructionSemantics2 {       // documented elsewhere
 
 /** A concrete semantic domain.
@@ -517,6 +523,163 @@ protected:
     BaseSemantics::SValuePtr doubleToExpr(double d, SgAsmFloatType*);
 };
 
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Block translation cache
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Shared-ownership pointer to a block translation cache. See @ref heap_object_shared_ownership. */
+typedef boost::shared_ptr<class BlockCache> BlockCachePtr;
+
+/** Executes basic blocks from cached translations.
+ *
+ *  Processing an instruction with a @ref BaseSemantics::Dispatcher makes dozens of virtual RISC operator calls, each of which
+ *  allocates a new value, and a simulator does that same work every time a loop body runs. A block cache records the RISC
+ *  operators that the dispatcher invokes the first time it executes a basic block and lowers them to a compact sequence of
+ *  micro-operations on 64-bit integers. Later executions of the block replay those micro-operations over a flat register file
+ *  that's loaded from the register state when the block starts and stored back when it ends. Memory is read and written
+ *  directly through the @ref MemoryState's memory map.
+ *
+ *  Whenever the dispatcher looks at a concrete value while a block is being recorded (a "rep" loop count, a divisor that it
+ *  checks for zero, etc.) the recording gets a guard for that value. If a guard fails during replay, the partial effects of that
+ *  instruction are undone and the instruction is handed to the dispatcher instead, as are all later executions of it.
+ *  Instructions that can't be lowered at all are always handed to the dispatcher: those with values wider than 64 bits,
+ *  floating-point operations, interrupts, and the other operations whose effects aren't limited to the register and memory
+ *  states. Therefore a subclass of @ref RiscOperators that overrides those operations (e.g., to emulate system calls) still
+ *  sees every call. The instruction counter is updated for replayed instructions, but @ref
+ *  BaseSemantics::RiscOperators::startInstruction "startInstruction" and @ref
+ *  BaseSemantics::RiscOperators::finishInstruction "finishInstruction" are called only for dispatched instructions.
+ *
+ *  A write to memory that holds translated or decoded instructions discards them, whether the write is from a replayed block
+ *  or an instruction processed by the dispatcher through this cache. Memory changed by other means, such as by a simulated
+ *  system call, must be reported with @ref invalidate.
+ *
+ *  The dispatcher's current state must have a @ref MemoryState with a memory map, from which instructions are decoded. Blocks
+ *  are translated only if the dispatcher's RISC operators are @ref ConcreteSemantics operators with no initial state and no
+ *  hot patches. A subclass of @ref RiscOperators might override operations that replaying would bypass, so its operators are
+ *  translated only if @ref translatesSubclasses is set. Otherwise every instruction is processed by the dispatcher.
+ *
+ * @code
+ *  BaseSemantics::DispatcherPtr cpu = disassembler->dispatcher()->create(ops);
+ *  ConcreteSemantics::BlockCachePtr cache = ConcreteSemantics::BlockCache::instance(disassembler, cpu);
+ *  while (true)
+ *      cache->execute();
+ * @endcode */
+class BlockCache {
+public:
+    /** Counters describing the work done by a cache. */
+    struct Statistics {
+        size_t nTranslations = 0;                       /**< Number of blocks recorded and lowered to micro-operations. */
+        size_t nReplays = 0;                            /**< Number of times a translation was replayed. */
+        size_t nReplayedInsns = 0;                      /**< Number of instructions executed by replaying translations. */
+        size_t nDispatchedInsns = 0;                    /**< Number of instructions processed by the dispatcher. */
+        size_t nGuardFailures = 0;                      /**< Number of replayed instructions that failed a guard. */
+        size_t nInvalidations = 0;                      /**< Number of translations discarded because their code changed. */
+    };
+
+private:
+    struct MicroOp;
+    struct Translation;
+    class Value;
+    class Recorder;
+    typedef boost::shared_ptr<Translation> TranslationPtr;
+    typedef boost::shared_ptr<Recorder> RecorderPtr;
+
+    // Bytes overwritten by a replayed instruction, so they can be restored if a later guard in that instruction fails.
+    struct Undo {
+        rose_addr_t va;
+        size_t nBytes;
+        uint8_t bytes[8];
+    };
+
+    Disassembler *disassembler_;
+    BaseSemantics::DispatcherPtr cpu_;
+    RecorderPtr recorder_;
+    size_t maxBlockSize_;
+    bool translatesSubclasses_;
+    std::map<rose_addr_t, TranslationPtr> translations_; // translations indexed by starting address
+    std::map<rose_addr_t, SgAsmInstruction*> insns_;   // decoded instructions
+    AddressIntervalSet code_;                           // bytes occupied by decoded instructions
+    std::set<rose_addr_t> unstable_;                    // instructions whose guards have failed
+    TranslationPtr active_;                             // translation being recorded or replayed
+    bool activeInvalidated_;                            // whether active_ has been invalidated
+    Statistics stats_;
+
+    // Scratch space for replaying, reused to avoid allocation
+    std::vector<uint64_t> slots_;
+    std::vector<uint64_t> file_;
+    std::vector<uint64_t> savedFile_;
+    std::vector<Undo> undo_;
+
+protected:
+    BlockCache(Disassembler*, const BaseSemantics::DispatcherPtr&);
+
+public:
+    ~BlockCache();
+
+    /** Allocating constructor.
+     *
+     *  The disassembler decodes instructions from the memory map of the dispatcher's current memory state, and the dispatcher
+     *  executes the instructions that aren't replayed from translations. */
+    static BlockCachePtr instance(Disassembler*, const BaseSemantics::DispatcherPtr&);
+
+    /** Property: Dispatcher.
+     *
+     *  This is the dispatcher supplied to the constructor. Its RISC operators are temporarily replaced while @ref execute is
+     *  running. */
+    BaseSemantics::DispatcherPtr dispatcher() const { return cpu_; }
+
+    /** Property: Maximum number of instructions per translation.
+     *
+     * @{ */
+    size_t maxBlockSize() const { return maxBlockSize_; }
+    void maxBlockSize(size_t n) { maxBlockSize_ = std::max(n, (size_t)1); }
+    /** @} */
+
+    /** Property: Whether to translate blocks for subclasses of the concrete RISC operators.
+     *
+     *  Replaying a translation reads and writes registers and memory without calling the RISC operators, so a subclass that
+     *  overrides operations other than those that are always dispatched (e.g., to trace memory accesses) would not see those
+     *  calls. Therefore blocks are translated only if the dispatcher's operators are exactly @ref RiscOperators, unless this
+     *  property is set. The default is false.
+     *
+     * @{ */
+    bool translatesSubclasses() const { return translatesSubclasses_; }
+    void translatesSubclasses(bool b) { translatesSubclasses_ = b; }
+    /** @} */
+
+    /** Execute instructions starting at the current instruction pointer.
+     *
+     *  Executes at most one basic block, either by replaying its translation, by recording a new translation, or by handing
+     *  instructions to the dispatcher, and returns the number of instructions executed. Exceptions thrown by the dispatcher
+     *  or disassembler are propagated, in which case the instructions before the one that failed have been executed. */
+    size_t execute();
+
+    /** Discard translations and decoded instructions overlapping the specified addresses.
+     *
+     *  This must be called when memory containing instructions is changed by anything other than this cache. */
+    void invalidate(const AddressInterval&);
+
+    /** Discard all translations and decoded instructions. */
+    void clear();
+
+    /** Counters describing the work done so far. */
+    const Statistics& statistics() const { return stats_; }
+
+private:
+    bool canTranslate() const;
+    MemoryStatePtr memoryState() const;
+    rose_addr_t instructionPointer() const;
+    SgAsmInstruction* instruction(rose_addr_t va);
+    size_t dispatch(SgAsmInstruction*);
+    size_t translate(rose_addr_t va);
+    size_t replay(const TranslationPtr&);
+    bool replayLoad(const MemoryMap::Ptr&, const MicroOp&, uint64_t *slots) const;
+    bool replayStore(const MemoryMap::Ptr&, const MicroOp&, uint64_t *slots);
+    void insertDispatched(SgAsmInstruction*);
+    void memoryWritten(const AddressInterval&);
+};
+
 } // namespace
 } // namespace
 } // namespace
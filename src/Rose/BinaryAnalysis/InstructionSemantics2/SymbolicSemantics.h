@@ -13,6 +13,8 @@
 #include <Rose/BinaryAnalysis/SmtSolver.h>
 #include <Rose/BinaryAnalysis/SymbolicExpr.h>
 
+#include <Sawyer/HashMap.h>
+
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/export.hpp>
@@ -749,6 +751,200 @@ public:
 
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Indexed list-based Memory state
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Shared-ownership pointer to symbolic memory state. See @ref heap_object_shared_ownership. */
+typedef boost::shared_ptr<class MemoryIndexedState> MemoryIndexedStatePtr;
+
+/** Byte-addressable memory.
+ *
+ *  This memory state has the same cells and the same aliasing semantics as the list-based state (@ref MemoryListState), from
+ *  which it is derived. Analyses that expect a @ref BaseSemantics::MemoryCellList work with it unchanged. The difference is
+ *  speed. A list-based state scans its cells in reverse chronological order on every read. This state also keeps an index of
+ *  the cells. The index maps each concrete address to its most recent cell, and it keeps a short chronological list of the
+ *  cells whose addresses are not concrete. Two one-byte cells at different concrete addresses can never alias, so reading a
+ *  concrete address only needs to look at one indexed cell plus the newer non-concrete cells. Reads from non-concrete
+ *  addresses scan the whole list as before.
+ *
+ *  The index is built lazily and discarded whenever the cells might have been changed behind its back: by the non-const
+ *  @ref get_cells, @ref traverse, @ref merge, the cell erasing functions, @ref clear, or a write that erases occluded cells.
+ *  Code that holds a reference from @ref get_cells and changes the list after later memory operations, or that changes the
+ *  address of a cell directly, must call @ref get_cells again before the next read.
+ *
+ *  @sa MemoryListState, MemoryMapState */
+class MemoryIndexedState: public MemoryListState {
+public:
+    typedef MemoryListState Super;
+
+private:
+    struct IndexEntry {
+        BaseSemantics::MemoryCellPtr cell;
+        uint64_t generation;                            // larger generations are more recent
+
+        IndexEntry()
+            : generation(0) {}
+        IndexEntry(const BaseSemantics::MemoryCellPtr &cell, uint64_t generation)
+            : cell(cell), generation(generation) {}
+    };
+
+    bool indexValid_;                                   // whether the following data members describe the cell list
+    Sawyer::Container::HashMap<uint64_t, IndexEntry> concreteCells_; // most recent one-byte cell for each concrete address
+    std::vector<IndexEntry> otherCells_;                // other cells in chronological order
+    size_t concreteWidth_;                              // width of the addresses in concreteCells_, or zero if none yet
+    uint64_t generation_;                               // generation of most recent cell
+    size_t nIndexedLookups_;                            // number of lookups that didn't need to scan the whole list
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Serialization
+#ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
+private:
+    friend class boost::serialization::access;
+
+    template<class S>
+    void serialize(S &s, const unsigned /*version*/) {
+        s & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Super);
+    }
+#endif
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Real constructors
+protected:
+    MemoryIndexedState()                                // for serialization
+        : indexValid_(false), concreteWidth_(0), generation_(0), nIndexedLookups_(0) {}
+
+    explicit MemoryIndexedState(const BaseSemantics::MemoryCellPtr &protocell)
+        : MemoryListState(protocell), indexValid_(false), concreteWidth_(0), generation_(0), nIndexedLookups_(0) {}
+
+    MemoryIndexedState(const BaseSemantics::SValuePtr &addrProtoval, const BaseSemantics::SValuePtr &valProtoval)
+        : MemoryListState(addrProtoval, valProtoval), indexValid_(false), concreteWidth_(0), generation_(0),
+          nIndexedLookups_(0) {}
+
+    // The index refers to the other state's cells, so the copy builds its own when it's first needed.
+    MemoryIndexedState(const MemoryIndexedState &other)
+        : MemoryListState(other), indexValid_(false), concreteWidth_(0), generation_(0), nIndexedLookups_(0) {}
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Static allocating constructors
+public:
+    /** Instantiates a new memory state having specified prototypical cells and value. */
+    static MemoryIndexedStatePtr instance(const BaseSemantics::MemoryCellPtr &protocell) {
+        return MemoryIndexedStatePtr(new MemoryIndexedState(protocell));
+    }
+
+    /** Instantiates a new memory state having specified prototypical value.  This constructor uses BaseSemantics::MemoryCell
+     *  as the cell type. */
+    static MemoryIndexedStatePtr instance(const BaseSemantics::SValuePtr &addrProtoval,
+                                          const BaseSemantics::SValuePtr &valProtoval) {
+        return MemoryIndexedStatePtr(new MemoryIndexedState(addrProtoval, valProtoval));
+    }
+
+    /** Instantiates a new deep copy of an existing state. */
+    static MemoryIndexedStatePtr instance(const MemoryIndexedStatePtr &other) {
+        return MemoryIndexedStatePtr(new MemoryIndexedState(*other));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Virtual constructors
+public:
+    /** Virtual constructor. Creates a memory state having specified prototypical value.  This constructor uses
+     * BaseSemantics::MemoryCell as the cell type. */
+    virtual BaseSemantics::MemoryStatePtr create(const BaseSemantics::SValuePtr &addrProtoval,
+                                                 const BaseSemantics::SValuePtr &valProtoval) const ROSE_OVERRIDE {
+        return instance(addrProtoval, valProtoval);
+    }
+
+    /** Virtual constructor. Creates a new memory state having specified prototypical cells and value. */
+    virtual BaseSemantics::MemoryStatePtr create(const BaseSemantics::MemoryCellPtr &protocell) const ROSE_OVERRIDE {
+        return instance(protocell);
+    }
+
+    /** Virtual copy constructor. Creates a new deep copy of this memory state. */
+    virtual BaseSemantics::MemoryStatePtr clone() const ROSE_OVERRIDE {
+        return BaseSemantics::MemoryStatePtr(new MemoryIndexedState(*this));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Dynamic pointer casts
+public:
+    /** Recasts a base pointer to a symbolic memory state. This is a checked cast that will fail if the specified pointer does
+     *  not have a run-time type that is a SymbolicSemantics::MemoryIndexedState or subclass thereof. */
+    static MemoryIndexedStatePtr promote(const BaseSemantics::MemoryStatePtr &x) {
+        MemoryIndexedStatePtr retval = boost::dynamic_pointer_cast<MemoryIndexedState>(x);
+        ASSERT_not_null(retval);
+        return retval;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Methods we override from the super class (documented in the super class)
+public:
+    virtual BaseSemantics::SValuePtr readMemory(const BaseSemantics::SValuePtr &addr, const BaseSemantics::SValuePtr &dflt,
+                                                BaseSemantics::RiscOperators *addrOps,
+                                                BaseSemantics::RiscOperators *valOps) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr peekMemory(const BaseSemantics::SValuePtr &addr, const BaseSemantics::SValuePtr &dflt,
+                                                BaseSemantics::RiscOperators *addrOps,
+                                                BaseSemantics::RiscOperators *valOps) ROSE_OVERRIDE;
+    virtual void writeMemory(const BaseSemantics::SValuePtr &addr, const BaseSemantics::SValuePtr &value,
+                             BaseSemantics::RiscOperators *addrOps, BaseSemantics::RiscOperators *valOps) ROSE_OVERRIDE;
+    virtual void clear() ROSE_OVERRIDE;
+    virtual bool merge(const BaseSemantics::MemoryStatePtr &other, BaseSemantics::RiscOperators *addrOps,
+                       BaseSemantics::RiscOperators *valOps) ROSE_OVERRIDE;
+    virtual void eraseMatchingCells(const BaseSemantics::MemoryCell::Predicate&) ROSE_OVERRIDE;
+    virtual void eraseLeadingCells(const BaseSemantics::MemoryCell::Predicate&) ROSE_OVERRIDE;
+    virtual void traverse(BaseSemantics::MemoryCell::Visitor&) ROSE_OVERRIDE;
+    virtual BaseSemantics::AddressSet getWritersUnion(const BaseSemantics::SValuePtr &addr, size_t nBits,
+                                                      BaseSemantics::RiscOperators *addrOps,
+                                                      BaseSemantics::RiscOperators *valOps) ROSE_OVERRIDE;
+    virtual BaseSemantics::AddressSet getWritersIntersection(const BaseSemantics::SValuePtr &addr, size_t nBits,
+                                                             BaseSemantics::RiscOperators *addrOps,
+                                                             BaseSemantics::RiscOperators *valOps) ROSE_OVERRIDE;
+    virtual const CellList& get_cells() const ROSE_OVERRIDE { return cells; }
+    virtual CellList& get_cells() ROSE_OVERRIDE;
+
+protected:
+    virtual BaseSemantics::MemoryCellPtr insertReadCell(const BaseSemantics::SValuePtr &addr,
+                                                        const BaseSemantics::SValuePtr &value) ROSE_OVERRIDE;
+    virtual BaseSemantics::MemoryCellPtr insertReadCell(const BaseSemantics::SValuePtr &addr,
+                                                        const BaseSemantics::SValuePtr &value,
+                                                        const BaseSemantics::AddressSet &writers,
+                                                        const BaseSemantics::InputOutputPropertySet &props) ROSE_OVERRIDE;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Methods first declared in this class
+public:
+    /** Find the cells that might alias an address.
+     *
+     *  Returns the same cells as @ref BaseSemantics::MemoryCellList::scan would when started at the beginning of the cell
+     *  list, in the same reverse chronological order, but uses the index when the address is concrete. The @p exact argument
+     *  is set to true if the returned list ends with a cell that must alias the address, and false if the scan reached the
+     *  oldest cell without finding one. */
+    CellList aliasingCells(const BaseSemantics::SValuePtr &addr, size_t nBits, BaseSemantics::RiscOperators *addrOps,
+                           BaseSemantics::RiscOperators *valOps, bool &exact /*out*/);
+
+    /** Number of lookups answered by the index.
+     *
+     *  This is the number of calls to @ref aliasingCells, including those made by reads and writer queries, that were able to
+     *  skip the full list scan. It's useful when deciding whether this state is worthwhile for a particular analysis. */
+    size_t nIndexedLookups() const { return nIndexedLookups_; }
+
+private:
+    BaseSemantics::SValuePtr readOrPeekIndexed(const BaseSemantics::SValuePtr &address, const BaseSemantics::SValuePtr &dflt,
+                                               BaseSemantics::RiscOperators *addrOps, BaseSemantics::RiscOperators *valOps,
+                                               AllowSideEffects::Flag allowSideEffects);
+
+    // Build the index if it isn't valid.
+    void updateIndex();
+
+    // Add the most recent cell to a valid index.
+    void indexNewCell(const BaseSemantics::MemoryCellPtr&);
+
+    // Discard the index.
+    void invalidateIndex();
+};
+
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                      Default memory state
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1266,6 +1462,7 @@ public:
 BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::InstructionSemantics2::SymbolicSemantics::SValue);
 BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::InstructionSemantics2::SymbolicSemantics::MemoryListState);
 BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::InstructionSemantics2::SymbolicSemantics::MemoryMapState);
+BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::InstructionSemantics2::SymbolicSemantics::MemoryIndexedState);
 BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::InstructionSemantics2::SymbolicSemantics::RiscOperators);
 #endif
 
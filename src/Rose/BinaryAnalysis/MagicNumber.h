@@ -10,24 +10,42 @@ namespace BinaryAnalysis {
 
 /** Identifies magic numbers in binaries.
  *
- *  The analysis constructor parses and stores the system's magic(5) files, which is then reused for each query. */
+ *  The analysis constructor parses and stores the system's magic(5) files, or prepares the built-in signatures, which are then
+ *  reused for each query. */
 class MagicNumberDetails;
 
 class MagicNumber {
 public:
-    enum Mechanism { FAST, SLOW, NONE };
+    /** How magic numbers are identified. See @ref mechanism. */
+    enum Mechanism {
+        FAST,                                           /**< libmagic, using the system's magic(5) files. */
+        SLOW,                                           /**< Run the file(1) command on a temporary file for each query. */
+        NONE,                                           /**< Identification is not supported. */
+        BUILTIN                                         /**< ROSE's built-in table of common signatures. */
+    };
 
 private:
     MagicNumberDetails *details_;
     Mechanism mechanism_;
     size_t maxBytes_;
+    size_t nThreads_;                                   // threads for batch queries; zero means use the global setting
 
 public:
-    /** Create a magic number analyzer. */
-    MagicNumber(): details_(NULL), maxBytes_(256) {
+    /** Create a magic number analyzer.
+     *
+     *  The analyzer uses libmagic if it's available, and the file(1) command otherwise. The built-in signatures are only used
+     *  when requested with the @ref BUILTIN mechanism. */
+    MagicNumber(): details_(NULL), maxBytes_(256), nThreads_(0) {
         init();
     }
 
+    /** Create a magic number analyzer using a specific mechanism.
+     *
+     *  Throws a <code>std::runtime_error</code> if the mechanism is not available on this system. */
+    explicit MagicNumber(Mechanism mechanism): details_(NULL), maxBytes_(256), nThreads_(0) {
+        init(mechanism);
+    }
+
     ~MagicNumber();
 
     /** Property: The mechanism being used to find magic numbers.
@@ -39,8 +57,13 @@ public:
      *  @li If libmagic is not available and this is a Unix machine, then the file(1) command is invoked on a temporary
      *  file. The return value in this case is @ref SLOW.
      *
-     *  @li If this is Windows and the libmagic library is not available then the return value is NONE. In this case, all calls
-     *  to identify will throw a <code>std::runtime_error</code>.
+     *  @li If this is Windows and the libmagic library is not available then the return value is @ref NONE. In this case,
+     *  all calls to identify will throw a <code>std::runtime_error</code>.
+     *
+     *  @li The @ref BUILTIN mechanism uses ROSE's built-in signature table. The table is compiled into an index the first time
+     *  it's used, and queries run entirely in this process. It recognizes common executable, archive, compression, image, and
+     *  document formats, but is not nearly as comprehensive as the system's magic(5) database, so it is only used when
+     *  requested explicitly with the constructor.
      *
      *  This property is read-only. */
     Mechanism mechanism() const { return mechanism_; }
@@ -56,11 +79,46 @@ public:
     void maxBytesToCheck(size_t n) { maxBytes_ = n; }
     /** @} */
 
-    /** Identify the magic number at the specified address. */
+    /** Property: Number of threads for identifying many addresses at once.
+     *
+     *  If zero, then the number of threads comes from the global "--threads" command-line switch, and if that is also zero
+     *  then the hardware concurrency is used. The @ref SLOW mechanism is always single threaded.
+     *
+     * @{ */
+    size_t nThreads() const { return nThreads_; }
+    void nThreads(size_t n) { nThreads_ = n; }
+    /** @} */
+
+    /** Identify the magic number at the specified address.
+     *
+     *  Thread safety: This function is thread safe. */
     std::string identify(const MemoryMap::Ptr&, rose_addr_t va) const;
 
+    /** Identify the magic numbers at many addresses.
+     *
+     *  Returns one description per address, in the same order as the addresses. The addresses are divided among
+     *  worker threads (see @ref nThreads), which is much faster than calling the single-address version in a loop when
+     *  there are many addresses, such as when scanning a whole memory map. */
+    std::vector<std::string> identify(const MemoryMap::Ptr&, const std::vector<rose_addr_t> &vas) const;
+
+    /** Identify the magic number in a buffer.
+     *
+     *  At most @ref maxBytesToCheck bytes of the buffer are examined.
+     *
+     *  Thread safety: This function is thread safe. */
+    std::string identify(const uint8_t *buf, size_t nBytes) const;
+
+    /** Identify a buffer using only the built-in signatures.
+     *
+     *  Returns a description similar to that of file(1), or "data" if nothing matches. This is the function used by the
+     *  @ref BUILTIN mechanism, and it is available regardless of the analyzer's mechanism.
+     *
+     *  Thread safety: This function is thread safe. */
+    static std::string identifyBuiltin(const uint8_t *buf, size_t nBytes);
+
 private:
     void init();
+    void init(Mechanism);
 };
 
 } // namespace
@@ -9,6 +9,8 @@
 #include <Rose/BinaryAnalysis/SmtSolver.h>
 #include <Rose/BinaryAnalysis/Partitioner2/BasicTypes.h>
 #include <Sawyer/Stopwatch.h>
+#include <atomic>
+#include <memory>
 #include <thread>
 
 namespace Rose {
@@ -31,6 +33,12 @@ namespace ModelChecker {
  *  specification is detected, then a tag describing the violation can be attached to the path and the path can be added to a
  *  second priority queue that holds the "interesting" paths.
  *
+ *  Each managed worker thread has its own work queue. New paths created by a worker are placed in that worker's queue and
+ *  the worker takes its next path from its own queue, which is ordered by the @ref explorationPrioritizer. A worker whose
+ *  queue is empty takes work from the shared queue (where starting points and paths created by user threads are placed) or
+ *  steals the highest priority path from another worker's queue. Thus the exploration order follows the prioritizer only
+ *  approximately when there is more than one worker.
+ *
  *  The engine is mainly responsible containing the prioritiy queues, managing worker threads and knowing about user threads,
  *  and handing work out to the threads.  Many of the components of model checking are user-defined specializations of model
  *  checker base classes, and the @ref Engine is reponsible for pointing to all of them so their virtual functions can be
@@ -43,14 +51,40 @@ public:
     /** Reference counting pointer. */
     using Ptr = EnginePtr;
 
+    /** Statistics for one managed worker. */
+    struct WorkerStatistics {
+        size_t nPathsExplored = 0;                      /**< Number of paths explored by this worker. */
+        size_t nStepsExplored = 0;                      /**< Number of steps explored by this worker. */
+        size_t nPathsStolen = 0;                        /**< Number of paths this worker took from other workers' queues. */
+        size_t nPathsPending = 0;                       /**< Number of paths waiting in this worker's queue. */
+    };
+
+private:
+    struct WorkerQueue;
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Data members
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 private:
-    PathQueue frontier_;                                // paths with work remaining
+    PathQueue frontier_;                                // paths with work remaining that don't belong to any worker
     PathQueue interesting_;                             // paths that are interesting, placed here by workers
     SemanticCallbacksPtr semantics_;                    // various configurable semantic operations
 
+    // These are updated for every path, so they're not protected by the engine-wide mutex.
+    std::atomic<size_t> nPending_{0};                   // paths in all work queues, plus those being inserted
+    std::atomic<size_t> nWorking_{0};                   // number of threads working or looking for work to take
+    std::atomic<size_t> nIdle_{0};                      // number of managed workers waiting for newWork_
+    std::atomic<size_t> nPathsExplored_{0};             // number of path nodes executed, i.e., number of paths explored
+    std::atomic<size_t> nStepsExplored_{0};             // number of steps executed
+    std::atomic<bool> stopping_{false};                 // when true, workers stop even if there is still work remaining
+
+    mutable SAWYER_THREAD_TRAITS::Mutex queuesMutex_;   // protects queues_ but not the queues themselves
+    std::vector<std::shared_ptr<WorkerQueue>> queues_;  // per-worker queues, parallel with workers_
+
+    mutable SAWYER_THREAD_TRAITS::Mutex fanoutMutex_;   // protects fanout_ and nFanoutRoots_
+    std::vector<std::pair<double, size_t>> fanout_;     // total fanout and number of nodes for each level of the forest
+    size_t nFanoutRoots_ = 0;                           // number of execution trees for calculating total forest size
+
     mutable SAWYER_THREAD_TRAITS::Mutex mutex_;         // protects all following data members
     SAWYER_THREAD_TRAITS::ConditionVariable newWork_;   // signaled when work arrives or thread finishes
     SAWYER_THREAD_TRAITS::ConditionVariable newInteresting_; // signaled when interesting paths arrive or threads finish
@@ -59,12 +93,6 @@ private:
     SettingsPtr settings_;                              // overall settings
     std::vector<std::thread> workers_;                  // managed worker threads
     size_t workCapacity_ = 0;                           // managed workers plus user threads
-    size_t nWorking_ = 0;                               // number of threads currently doing work
-    size_t nPathsExplored_ = 0;                         // number of path nodes executed, i.e., number of paths explored
-    size_t nStepsExplored_ = 0;                         // number of steps executed
-    bool stopping_ = false;                             // when true, workers stop even if there is still work remaining
-    std::vector<std::pair<double, size_t>> fanout_;     // total fanout and number of nodes for each level of the forest
-    size_t nFanoutRoots_ = 0;                           // number of execution trees for calculating total forest size
     Sawyer::Stopwatch elapsedTime_;                     // time since model checking started
     mutable Sawyer::Stopwatch timeSinceStats_;          // time since last statistics were reported
     mutable size_t nPathsStats_ = 0;                    // number of paths reported in last statistics output
@@ -277,7 +305,7 @@ public:
 
     /** Number of paths to explore.
      *
-     *  Returns the number of paths waiting to be explored.
+     *  Returns the number of paths waiting to be explored, including those in the per-worker queues.
      *
      *  Thread safety: This method is thread safe. */
     size_t nPathsPending() const;
@@ -308,6 +336,14 @@ public:
      *  Thread safety: This method is thread safe. */
     size_t nStepsExplored() const;
 
+    /** Statistics for each managed worker.
+     *
+     *  Returns one element per managed worker that has been started since the engine was created or reset, even if the
+     *  worker has since exited.
+     *
+     *  Thread safety: This method is thread safe. */
+    std::vector<WorkerStatistics> workerStatistics() const;
+
     /** Property: The interesting results queue.
      *
      *  As workers discover interesting things, they will insert those paths into the "interesting" queue. The queue can be
@@ -363,6 +399,8 @@ public:
     /** Insert a path into the execution tree.
      *
      *  The insertion is subject to the @ref explorationPredicate. If the predicate returns false then the path is not inserted.
+     *  When called from a managed worker, the path is inserted into that worker's own queue, otherwise it's inserted into the
+     *  shared queue.
      *
      *  Returns true if inserted, false if not inserted.
      *
@@ -379,7 +417,20 @@ private:
     void updateFanout(size_t nChildren, size_t totalSteps, size_t lastSteps);
 
     // Called by each worker thread when they start. Users should not call this even though it's public.
-    void worker();
+    void worker(const std::shared_ptr<WorkerQueue>&);
+
+    // The queue belonging to the calling thread if it's a managed worker of this engine, otherwise null.
+    WorkerQueue* currentQueue() const;
+
+    // Take a path from the calling worker's queue, the shared queue, or another worker's queue, in that order. Returns null if
+    // none are available. The caller must already be counted in nWorking_.
+    PathPtr findWork(WorkerQueue*);
+
+    // Decrement nWorking_, waking waiting workers if this was the last working thread. Must not hold the engine mutex.
+    void decrementWorking();
+
+    // Wake a waiting worker, if any, after new work was inserted. Must not hold the engine mutex.
+    void notifyNewWork();
 
     // Worker states.
     enum class WorkerState {
@@ -404,8 +455,8 @@ private:
     void finishWorkingNS();
 
     // Get the next path on which to work.  This function blocks until either more work is available, or no more work can
-    // possibly be available. In the former case, it removes the highest priority path from the work queue, changes the work
-    // state to WORKING, and returns the path. In the latter case, it returns a null pointer.
+    // possibly be available. In the former case, it removes a path from one of the work queues (see findWork), changes the
+    // work state to WORKING, and returns the path. In the latter case, it returns a null pointer.
     //
     // Thread safety: This method is thread safe.
     PathPtr takeNextWorkItem(WorkerState&);
@@ -41,6 +41,7 @@ struct Settings {
     Sawyer::Optional<rose_addr_t> initialStackVa;       /**< Address for initial stack pointer. */
     MemoryType memoryType = MemoryType::MAP;            /**< Type of memory state. */
     bool solverMemoization = true;                      /**< Whether the SMT solver should use memoization. */
+    bool copyOnWrite = false;                           /**< Share unchanged registers and memory cells between paths. */
 };
 
 class SemanticCallbacks;
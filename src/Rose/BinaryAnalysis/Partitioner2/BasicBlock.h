@@ -650,6 +650,10 @@ private:
     void thaw() { isFrozen_ = false; }
     BasicBlockSemantics undropSemanticsNS(const Partitioner&);
 
+    // Same as append, except dropped semantics stay dropped. Used when the block's properties are already known.
+    void appendWithoutSemantics(const Partitioner&, SgAsmInstruction*);
+    void appendNS(const Partitioner&, SgAsmInstruction*, bool undropSemantics);
+
     // Find an equivalent data block and replace it with the specified data block, or insert the specified data block.
     void replaceOrInsertDataBlock(const DataBlock::Ptr&);
 };
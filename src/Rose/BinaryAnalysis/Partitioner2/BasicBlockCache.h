@@ -0,0 +1,223 @@
+#ifndef ROSE_BinaryAnalysis_Partitioner2_BasicBlockCache_H
+#define ROSE_BinaryAnalysis_Partitioner2_BasicBlockCache_H
+#include <featureTests.h>
+#ifdef ROSE_ENABLE_BINARY_ANALYSIS
+
+#include <Rose/BinaryAnalysis/MemoryMap.h>
+#include <Rose/BinaryAnalysis/Partitioner2/BasicTypes.h>
+
+#include <boost/filesystem.hpp>
+#include <Sawyer/Map.h>
+#include <Sawyer/Optional.h>
+#include <Sawyer/SharedPointer.h>
+#include <Sawyer/Synchronization.h>
+
+#include <string>
+#include <vector>
+
+namespace Rose {
+namespace BinaryAnalysis {
+namespace Partitioner2 {
+
+class InstructionProvider;
+
+/** Content-addressed cache of basic block discovery results.
+ *
+ *  When many related specimens are partitioned (e.g., successive versions of the same product), most of their basic blocks
+ *  are byte-for-byte identical, yet the partitioner decodes them and runs their instruction semantics again for each
+ *  specimen. This cache remembers the outcome of discovering a basic block--its instructions, its successors and ghost
+ *  successors, whether it's a function call or return, whether it pops the stack, and its data blocks--so that a partitioner
+ *  which has this cache (see @ref Partitioner::basicBlockCache) can reconstruct the block without running instruction
+ *  semantics.
+ *
+ *  Each entry is identified by a SHA-256 digest of:
+ *
+ *  @li the partitioner's context, which describes the instruction set architecture and those partitioner settings that
+ *      affect how blocks are discovered,
+ *
+ *  @li the bytes of each instruction and its offset from the start of the block, and the memory access permissions for
+ *      those bytes,
+ *
+ *  @li for each integer constant in the instructions, the memory access permissions at that address, and
+ *
+ *  @li the address, bytes, and permissions of each data block and of the memory that the block's semantics read from the
+ *      memory map (i.e., memory that the partitioner's semantics treat as constant).
+ *
+ *  Most blocks are relocatable: their digests don't depend on where they are, and their successors are recorded either as
+ *  offsets from the start of the block or as references to the integer constants in their instructions, which the
+ *  disassembler has already relocated. Therefore the same code at a different address hits the cache. A block is tied to its
+ *  original address if it has data blocks, reads memory from the memory map, or has a concrete successor that is neither its
+ *  fall-through address nor one of its constants, since any of those might be absolute or relative addresses. A tied block's
+ *  address is part of its digest.
+ *
+ *  A lookup succeeds only if the memory map produces the same digest, so the cache can be shared by specimens that differ
+ *  elsewhere. The cache can be saved to and loaded from a file so that it persists across runs, and it keeps statistics
+ *  about how often it's used.
+ *
+ *  Thread safety: All methods are thread safe. */
+class BasicBlockCache: public Sawyer::SharedObject {
+public:
+    /** Shared-ownership pointer to a @ref BasicBlockCache. See @ref heap_object_shared_ownership. */
+    typedef Sawyer::SharedPointer<BasicBlockCache> Ptr;
+
+    /** A concrete control flow successor. */
+    struct Successor {
+        rose_addr_t address;                            /**< Successor address. */
+        EdgeType type;                                  /**< Type of control flow edge. */
+        Confidence confidence;                          /**< Confidence in the edge. */
+        Sawyer::Optional<size_t> constant;              /**< Index of the instruction constant having this address, if any. */
+
+        Successor()
+            : address(0), type(E_NORMAL), confidence(ASSUMED) {}
+        Successor(rose_addr_t va, EdgeType edgeType, Confidence edgeConfidence)
+            : address(va), type(edgeType), confidence(edgeConfidence) {}
+    };
+
+    /** Results of discovering one basic block.
+     *
+     *  All addresses are absolute. When an entry is inserted they describe the block that was discovered, and when an entry
+     *  is returned by @ref lookup they've been relocated to the address that was looked up. */
+    struct Entry {
+        std::string digest;                             /**< Content address; see class documentation. */
+        rose_addr_t address;                            /**< Starting address of the block. */
+        bool isRelocatable;                             /**< Whether the entry can match at other addresses. */
+        std::string firstInsnBytes;                     /**< Encoding of the first instruction; indexes relocatable entries. */
+        std::vector<AddressInterval> instructions;      /**< Location of each instruction, in block order. */
+        std::vector<AddressInterval> dataBlocks;        /**< Location of each data block owned by the basic block. */
+        AddressIntervalSet memoryRead;                  /**< Memory read by the semantics from the memory map. */
+        std::vector<Successor> successors;              /**< Concrete successors. */
+        std::vector<Successor> ghostSuccessors;         /**< Ghost successors. Only addresses and constants are used. */
+        bool hasIndeterminateSuccessor;                 /**< Whether there's also a successor that isn't concrete. */
+        bool isFunctionCall;                            /**< Whether the block is semantically a function call. */
+        bool isFunctionReturn;                          /**< Whether the block is semantically a function return. */
+        bool popsStack;                                 /**< Whether the block has a net stack popping effect. */
+        bool terminatedByContent;                       /**< Block ends because of its own content, not the CFG's. */
+
+        Entry()
+            : address(0), isRelocatable(false), hasIndeterminateSuccessor(false), isFunctionCall(false),
+              isFunctionReturn(false), popsStack(false), terminatedByContent(false) {}
+    };
+
+    /** Counters describing how the cache has been used. */
+    struct Statistics {
+        size_t nLookups;                                /**< Number of calls to @ref lookup. */
+        size_t nHits;                                   /**< Number of lookups that found a matching entry. */
+        size_t nRejected;                               /**< Number of hits the partitioner couldn't use. See @ref reject. */
+        size_t nInserts;                                /**< Number of entries inserted or replaced. */
+
+        Statistics()
+            : nLookups(0), nHits(0), nRejected(0), nInserts(0) {}
+
+        /** Ratio of useful hits to lookups. Returns zero if there have been no lookups. */
+        double hitRate() const {
+            return nLookups > 0 ? (double)(nHits - nRejected) / nLookups : 0.0;
+        }
+    };
+
+private:
+    typedef Sawyer::Container::Map<rose_addr_t, std::vector<Entry> > Entries;
+    typedef Sawyer::Container::Map<std::string, std::vector<Entry> > RelocatableEntries;
+
+    mutable SAWYER_THREAD_TRAITS::Mutex mutex_;         // protects all following data members
+    Entries entries_;                                   // entries tied to an address, indexed by that address
+    RelocatableEntries relocatable_;                    // relocatable entries indexed by the bytes of their first instruction
+    size_t maxEntriesPerAddress_;
+    Statistics stats_;
+
+protected:
+    BasicBlockCache()
+        : maxEntriesPerAddress_(8) {}
+
+public:
+    /** Allocating constructor. */
+    static Ptr instance() {
+        return Ptr(new BasicBlockCache);
+    }
+
+    /** Property: Maximum number of entries per block address.
+     *
+     *  Related specimens often have different blocks at the same address. When a new entry is inserted and the address already
+     *  has this many entries, the oldest entry for that address is discarded. Relocatable entries are limited the same way per
+     *  first instruction encoding.
+     *
+     * @{ */
+    size_t maxEntriesPerAddress() const;
+    void maxEntriesPerAddress(size_t);
+    /** @} */
+
+    /** Number of entries in the cache. */
+    size_t size() const;
+
+    /** Remove all entries. The statistics are not reset. */
+    void clear();
+
+    /** Find an entry for a block.
+     *
+     *  Looks for an entry for a block that starts at the specified address, or a relocatable entry whose first instruction has
+     *  the same bytes, and whose digest, computed from the specified memory map and context, matches. The instructions are
+     *  obtained from the instruction provider. Returns the entry relocated to the specified address, or nothing if there's no
+     *  match. */
+    Sawyer::Optional<Entry> lookup(const std::string &context, rose_addr_t va, const MemoryMap::Ptr&,
+                                   const InstructionProvider&);
+
+    /** Record that a hit could not be used.
+     *
+     *  The partitioner calls this when an entry matched but the block it describes cannot be reconstructed because the
+     *  partitioner's control flow graph would cause the block to end at a different instruction. */
+    void reject();
+
+    /** Insert or replace an entry.
+     *
+     *  The entry's @c digest, @c isRelocatable, @c firstInsnBytes, and successor @c constant members are computed from the
+     *  context, memory map, and instructions, which must be the instructions described by the entry. Returns false without
+     *  inserting anything if the digest cannot be computed because some of the bytes are not mapped. */
+    bool insert(const std::string &context, const MemoryMap::Ptr&, const std::vector<SgAsmInstruction*>&, Entry);
+
+    /** Compute the digest for a block.
+     *
+     *  The entry supplies the block's address, data blocks, memory read, and whether it's relocatable. Returns an empty string
+     *  if some of the instruction, data, or memory-read bytes are not mapped. */
+    static std::string digest(const std::string &context, const MemoryMap::Ptr&, const std::vector<SgAsmInstruction*>&,
+                              const Entry&);
+
+    /** Integer constants of instructions.
+     *
+     *  Returns the values of the integer constants in the instructions' ASTs, in preorder. @ref Successor::constant is an
+     *  index into this list. */
+    static std::vector<rose_addr_t> constants(const std::vector<SgAsmInstruction*>&);
+
+    /** Statistics.
+     *
+     * @{ */
+    Statistics statistics() const;
+    void resetStatistics();
+    /** @} */
+
+    /** Save the cache to a file.
+     *
+     *  Throws an @ref Exception if the file cannot be written. */
+    void save(const boost::filesystem::path&) const;
+
+    /** Load entries from a file.
+     *
+     *  The entries are added to those already in the cache. Throws an @ref Exception if the file cannot be read or is not a
+     *  basic block cache. */
+    void load(const boost::filesystem::path&);
+
+    /** Print statistics. */
+    void print(std::ostream&) const;
+
+private:
+    void insertNS(const Entry&);
+    static Sawyer::Optional<Entry> relocate(const std::string &context, rose_addr_t va, const MemoryMap::Ptr&,
+                                            const InstructionProvider&, const Entry&);
+};
+
+std::ostream& operator<<(std::ostream&, const BasicBlockCache&);
+
+} // namespace
+} // namespace
+} // namespace
+
+#endif
+#endif
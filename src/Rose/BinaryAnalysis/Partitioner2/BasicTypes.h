@@ -83,7 +83,8 @@ enum Confidence {
 /** Organization of semantic memory. */
 enum SemanticMemoryParadigm {
     LIST_BASED_MEMORY,                                  /**< Precise but slow. */
-    MAP_BASED_MEMORY                                    /**< Fast but not precise. */
+    MAP_BASED_MEMORY,                                   /**< Fast but not precise. */
+    INDEXED_MEMORY                                      /**< Precise like list-based, but indexes concrete addresses. */
 };
 
 /** Settings that control building the AST.
@@ -236,11 +237,17 @@ struct LoaderSettings {
                                                      *   launching a "run:" specimen. Each string must contain an equal sign
                                                      *   that separates the name from the value (the first \"=\" if more
                                                      *   than one. */
+    bool lazyParsing;                               /**< Parse container tables on demand. If set, container files are
+                                                     *   memory mapped rather than read, and tables that aren't needed to
+                                                     *   load the specimen (symbols, relocations, dynamic linking, notes,
+                                                     *   error frames, exports) are decoded only when something uses them.
+                                                     *   See @ref SgAsmGenericFile::get_lazy_parsing. */
 
     LoaderSettings()
         : deExecuteZerosThreshold(0), deExecuteZerosLeaveAtFront(16), deExecuteZerosLeaveAtBack(1),
           memoryDataAdjustment(DATA_IS_INITIALIZED), memoryIsExecutable(false), linkObjectFiles(true),
-          linkStaticArchives(true), linker("ld -o %o --unresolved-symbols=ignore-all --whole-archive %f") {}
+          linkStaticArchives(true), linker("ld -o %o --unresolved-symbols=ignore-all --whole-archive %f"),
+          lazyParsing(false) {}
 
 private:
     friend class boost::serialization::access;
@@ -266,6 +273,8 @@ private:
                     envErasePatterns.push_back(boost::regex(reStr));
             }
         }
+        if (version >= 2)
+            s & BOOST_SERIALIZATION_NVP(lazyParsing);
     }
 };
 
@@ -390,6 +399,10 @@ struct PartitionerSettings {
     bool namingSyscalls;                            /**< Give names (comments) to system calls if possible. */
     boost::filesystem::path syscallHeader;          /**< Name of header file containing system call numbers. */
     bool demangleNames;                             /**< Run all names through a demangling step. */
+    bool discoveringInParallel;                     /**< Discover instructions and basic blocks with multiple threads before
+                                                     *   running the serial partitioning steps. The number of threads is
+                                                     *   controlled by the global "--threads" setting. */
+    boost::filesystem::path basicBlockCacheName;    /**< File holding cached basic block discovery results, if not empty. */
 
 private:
     friend class boost::serialization::access;
@@ -456,6 +469,16 @@ private:
             if (S::is_loading::value)
                 syscallHeader = temp;
         }
+        if (version >= 7)
+            s & BOOST_SERIALIZATION_NVP(discoveringInParallel);
+        if (version >= 8) {
+            std::string temp;
+            if (S::is_saving::value)
+                temp = basicBlockCacheName.string();
+            s & boost::serialization::make_nvp("basicBlockCacheName", temp);
+            if (S::is_loading::value)
+                basicBlockCacheName = temp;
+        }
     }
 
 public:
@@ -468,7 +491,7 @@ public:
           doingPostCallingConvention(false), doingPostFunctionNoop(false), functionReturnAnalysis(MAYRETURN_DEFAULT_YES),
           functionReturnAnalysisMaxSorts(50), findingDataFunctionPointers(false), findingCodeFunctionPointers(false),
           findingThunks(true), splittingThunks(false), semanticMemoryParadigm(LIST_BASED_MEMORY), namingConstants(true),
-          namingStrings(true), namingSyscalls(true), demangleNames(true) {}
+          namingStrings(true), namingSyscalls(true), demangleNames(true), discoveringInParallel(false) {}
 };
 
 // BOOST_CLASS_VERSION(PartitionerSettings, 1); -- see end of file (cannot be in a namespace)
@@ -510,9 +533,9 @@ typedef Sawyer::SharedPointer<ThunkPredicates> ThunkPredicatesPtr;
 } // namespace
 
 // Class versions must be at global scope
-BOOST_CLASS_VERSION(Rose::BinaryAnalysis::Partitioner2::PartitionerSettings, 6);
+BOOST_CLASS_VERSION(Rose::BinaryAnalysis::Partitioner2::PartitionerSettings, 8);
 BOOST_CLASS_VERSION(Rose::BinaryAnalysis::Partitioner2::BasePartitionerSettings, 1);
-BOOST_CLASS_VERSION(Rose::BinaryAnalysis::Partitioner2::LoaderSettings, 1);
+BOOST_CLASS_VERSION(Rose::BinaryAnalysis::Partitioner2::LoaderSettings, 2);
 BOOST_CLASS_VERSION(Rose::BinaryAnalysis::Partitioner2::DisassemblerSettings, 1);
 
 #endif
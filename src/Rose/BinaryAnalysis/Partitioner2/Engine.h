@@ -235,6 +235,7 @@ private:
 private:
     Settings settings_;                                 // Settings for the partitioner.
     SgAsmInterpretation *interp_;                       // interpretation set by loadSpecimen
+    SerialInput::Ptr pendingAsts_;                      // mapped RBA file whose ASTs have not been loaded yet
     BinaryLoader::Ptr binaryLoader_;                    // how to remap, link, and fixup
     Disassembler *disassembler_;                        // not ref-counted yet, but don't destroy it since user owns it
     MemoryMap::Ptr map_;                                // memory map initialized by load()
@@ -442,9 +443,18 @@ public:
     /** Load a partitioner and an AST from a file.
      *
      *  The specified RBA file is opened and read to create a new @ref Partitioner object and associated AST. The @ref
-     *  partition function also understands how to open RBA files. */
+     *  partition function also understands how to open RBA files.
+     *
+     *  If the file was saved in the @ref SerialIo::MAPPED format (which is detected automatically) then the AST is not read
+     *  until the @ref interpretation is first needed, which makes loading much faster for tools that use only the
+     *  partitioner. */
     virtual Partitioner loadPartitioner(const boost::filesystem::path&, SerialIo::Format fmt = SerialIo::BINARY);
 
+private:
+    // Load the ASTs whose loading was deferred by loadPartitioner.
+    void loadPendingAsts();
+public:
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Command-line parsing
     //
@@ -875,6 +885,26 @@ public:
      *  attachBlocksToFunctions tries to attach each basic block to a function. */
     virtual void discoverFunctions(Partitioner&);
 
+    /** Discover instructions and basic blocks in parallel.
+     *
+     *  Runs a multi-threaded @ref ParallelPartitioner::Partitioner starting at each function that's already known to the
+     *  specified partitioner, and then attaches the basic blocks it discovered to the specified partitioner. The parallel
+     *  partitioner assumes that all function calls return, so call-return edges are not transferred; the serial steps that
+     *  follow will add them according to the may-return analysis. The number of threads comes from the global "--threads"
+     *  command-line switch.
+     *
+     *  Returns the starting addresses of the basic blocks that were attached. This is called by @ref runPartitionerRecursive
+     *  when @ref discoveringInParallel is set. */
+    virtual std::vector<rose_addr_t> discoverInParallel(Partitioner&);
+
+    /** Remove unreachable basic blocks that were discovered in parallel.
+     *
+     *  Since @ref discoverInParallel assumes that all function calls return, it might discover basic blocks that follow calls
+     *  to functions that don't return. Once the serial partitioner has made its may-return decisions, this function erases
+     *  those blocks from the specified list that have no incoming control flow edges and are not function entry points, and
+     *  recursively any of their successors that become unreachable as a result. */
+    virtual void pruneParallelBasicBlocks(Partitioner&, const std::vector<rose_addr_t> &blockVas);
+
     /** Attach dead code to function.
      *
      *  Examines the ghost edges for the basic blocks that belong to the specified function in order to discover basic blocks
@@ -1053,8 +1083,8 @@ public:
      *  the user can reset it to DOS to disassemble the DOS part of the executable.
      *
      * @{ */
-    SgAsmInterpretation* interpretation() const /*final*/ { return interp_; }
-    virtual void interpretation(SgAsmInterpretation *interp) { interp_ = interp; }
+    SgAsmInterpretation* interpretation() const /*final*/;
+    virtual void interpretation(SgAsmInterpretation *interp);
     /** @} */
 
     /** Property: binary loader.
@@ -1150,6 +1180,16 @@ public:
     virtual void linkerCommand(const std::string &cmd) { settings_.loader.linker = cmd; }
     /** @} */
 
+    /** Property: Parse containers lazily.
+     *
+     *  If set, container files are memory mapped and tables that aren't needed to load the specimen are decoded only when
+     *  they're used. See @ref LoaderSettings::lazyParsing.
+     *
+     * @{ */
+    bool lazyParsing() const /*final*/ { return settings_.loader.lazyParsing; }
+    virtual void lazyParsing(bool b) { settings_.loader.lazyParsing = b; }
+    /** @} */
+
     /** Property: Environment variable erasure names.
      *
      *  This property is a list of environment variable names that will be removed before launching a "run:" style specimen.
@@ -1432,6 +1472,16 @@ public:
     virtual void doingPostAnalysis(bool b) { settings_.partitioner.doingPostAnalysis = b; }
     /** @} */
 
+    /** Property: Whether to discover instructions in parallel.
+     *
+     *  If set, then @ref runPartitionerRecursive calls @ref discoverInParallel to discover instructions and basic blocks using
+     *  multiple threads before running the serial partitioning steps.
+     *
+     * @{ */
+    bool discoveringInParallel() const /*final*/ { return settings_.partitioner.discoveringInParallel; }
+    virtual void discoveringInParallel(bool b) { settings_.partitioner.discoveringInParallel = b; }
+    /** @} */
+
     /** Property: Whether to run the function may-return analysis.
      *
      *  Determines whether the may-return analysis is run when @ref doingPostAnalysis is true.
@@ -1656,6 +1706,18 @@ public:
     virtual void systemCallHeader(const boost::filesystem::path &filename) { settings_.partitioner.syscallHeader = filename; }
     /** @} */
 
+    /** Property: File for caching basic block discovery results.
+     *
+     *  If this property is not empty, then the partitioner created by this engine uses a @ref BasicBlockCache that's loaded
+     *  from this file (if it exists) before partitioning and saved back to this file after partitioning.
+     *
+     * @{ */
+    const boost::filesystem::path& basicBlockCacheName() const /*final*/ { return settings_.partitioner.basicBlockCacheName; }
+    virtual void basicBlockCacheName(const boost::filesystem::path &filename) {
+        settings_.partitioner.basicBlockCacheName = filename;
+    }
+    /** @} */
+
     /** Property: Demangle names.
      *
      *  If this property is set, then names are passed through a demangle step, which generally converts them from a low-level
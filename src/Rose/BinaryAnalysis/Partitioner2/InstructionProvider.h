@@ -133,6 +133,13 @@ public:
      *  are not executable. */
     SgAsmInstruction* operator[](rose_addr_t va) const;
 
+    /** Cheaply decode the size and control flow of the instruction at the specified address.
+     *
+     *  This neither consults nor updates the instruction cache and never creates an instruction. It returns a zero size if the
+     *  disassembler is disabled, the address is not executable, or the disassembler's pre-decoder doesn't recognize the
+     *  instruction; in those cases use @ref operator[] instead. See @ref Disassembler::predecode. */
+    Disassembler::Predecoded predecode(rose_addr_t va) const;
+
     /** Insert an instruction into the cache.
      *
      *  This instruction provider saves a pointer to the instruction without taking ownership.  If an instruction already
@@ -17,7 +17,6 @@
 namespace Rose {
 namespace BinaryAnalysis {
 namespace Partitioner2 {
-namespace Experimental {
 namespace ParallelPartitioner {
 
 class Partitioner;
@@ -1054,6 +1053,31 @@ public:
      *  Thread safety: This function is not thread safe. */
     void transferResults(Rose::BinaryAnalysis::Partitioner2::Partitioner &out);
 
+    /** Transfer basic blocks to a serial partitioner.
+     *
+     *  Creates a basic block in the specified partitioner for each basic block of this partitioner's global control flow
+     *  graph and attaches it to the serial partitioner's CFG/AUM. Blocks that would conflict with something already attached
+     *  to the serial partitioner (a block at the same address, or an instruction that's already present) are skipped. The
+     *  instruction ASTs are also inserted into the serial partitioner's instruction provider so they're not decoded a second
+     *  time.
+     *
+     *  If @p callReturnEdges is false, then the assumed call-return edges that this partitioner creates for every function call
+     *  are not transferred, leaving the serial partitioner's may-return analysis to decide whether such edges exist.
+     *
+     *  Returns the starting addresses of the basic blocks that were attached.
+     *
+     *  Thread safety: This function is not thread safe. */
+    std::vector<rose_addr_t> transferBasicBlocks(Rose::BinaryAnalysis::Partitioner2::Partitioner &out,
+                                                 bool callReturnEdges = true);
+
+    /** Transfer functions to a serial partitioner.
+     *
+     *  Assigns instructions to functions (see @ref assignFunctions) and then attaches or merges those functions into the
+     *  specified partitioner. The basic blocks should have been already transferred with @ref transferBasicBlocks.
+     *
+     *  Thread safety: This function is not thread safe. */
+    void transferFunctions(Rose::BinaryAnalysis::Partitioner2::Partitioner &out);
+
     /** Figure out how to remap memory.
      *
      *  Based on how function calls line up with function entry points, try to figure out if there's a way we could rearrange
@@ -1063,7 +1087,12 @@ public:
 
 
 } // namespace
+
+// Backward compatibility. The parallel partitioner was originally experimental.
+namespace Experimental {
+namespace ParallelPartitioner = Rose::BinaryAnalysis::Partitioner2::ParallelPartitioner;
 } // namespace
+
 } // namespace
 } // namespace
 } // namespace
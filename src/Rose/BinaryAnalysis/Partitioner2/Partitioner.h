@@ -5,6 +5,7 @@
 
 #include <Rose/BinaryAnalysis/Partitioner2/AddressUsageMap.h>
 #include <Rose/BinaryAnalysis/Partitioner2/BasicBlock.h>
+#include <Rose/BinaryAnalysis/Partitioner2/BasicBlockCache.h>
 #include <Rose/BinaryAnalysis/Partitioner2/BasicTypes.h>
 #include <Rose/BinaryAnalysis/Partitioner2/Config.h>
 #include <Rose/BinaryAnalysis/Partitioner2/ControlFlowGraph.h>
@@ -34,6 +35,7 @@
 #include <boost/serialization/split_member.hpp>
 #include <boost/serialization/version.hpp>
 
+#include <functional>
 #include <ostream>
 #include <set>
 #include <string>
@@ -359,6 +361,7 @@ private:
     Unparser::BasePtr unparser_;                        // For unparsing things to pseudo-assembly
     Unparser::BasePtr insnUnparser_;                    // For unparsing single instructions in diagnostics
     Unparser::BasePtr insnPlainUnparser_;               // For unparsing just instruction mnemonic and operands
+    BasicBlockCache::Ptr basicBlockCache_;              // Optional cache of discovery results shared across partitioners
 
     // Callback lists
     CfgAdjustmentCallbacks cfgAdjustmentCallbacks_;
@@ -416,6 +419,7 @@ private:
         s.template register_type<Semantics::RegisterState>();
         s.template register_type<Semantics::State>();
         s.template register_type<Semantics::RiscOperators>();
+        s.template register_type<Semantics::MemoryIndexedState>(); // registered last so older archives still load
         s & BOOST_SERIALIZATION_NVP(settings_);
         // s & config_;                         -- FIXME[Robb P Matzke 2016-11-08]
         s & BOOST_SERIALIZATION_NVP(instructionProvider_);
@@ -1284,6 +1288,28 @@ public:
     BasicBlock::Ptr discoverBasicBlock(const ControlFlowGraph::ConstVertexIterator &placeholder) const /*final*/;
     /** @} */
 
+    /** Property: Cache of basic block discovery results.
+     *
+     *  If non-null, then @ref discoverBasicBlock consults this cache before decoding instructions and running their
+     *  semantics, and stores its results in the cache afterward. A cache hit reconstructs the block's instructions, successors,
+     *  ghost successors, data blocks, and stack popping, function call, and function return properties without running
+     *  instruction semantics (the semantics are left in the dropped state and are recomputed if something needs them), after
+     *  which the basic block callbacks are invoked once for their side effects. A hit is not used, and the block is
+     *  discovered in the usual way, if the partitioner's control flow graph would cause the block to end at a different
+     *  instruction than when it was cached, or if the configuration has information about the block.
+     *
+     *  The same cache object can be shared by many partitioners, even concurrently, and can be saved to a file in order to
+     *  reuse results when analyzing related specimens. Entries are specific to a context that includes the instruction set
+     *  architecture and the partitioner settings that affect discovery, but the cache assumes that partitioners sharing it
+     *  use the same basic block callbacks. See @ref BasicBlockCache for details.
+     *
+     *  Thread safety: Not thread safe.
+     *
+     * @{ */
+    BasicBlockCache::Ptr basicBlockCache() const /*final*/ { return basicBlockCache_; }
+    void basicBlockCache(const BasicBlockCache::Ptr &cache) { basicBlockCache_ = cache; }
+    /** @} */
+
     /** Determine successors for a basic block.
      *
      *  Basic block successors are returned as a vector in no particular order.  This method returns the most basic successors;
@@ -1948,6 +1974,22 @@ public:
      *  Thread safety: Not thread safe. */
     FunctionCallGraph functionCallGraph(AllowParallelEdges::Type allowParallelEdges) const /*final*/;
 
+    /** Run an analysis on all functions, callees before callers.
+     *
+     *  Invokes @p analysis once for each function, choosing an order so that each function's callees are analyzed before the
+     *  function itself. Functions that are mutually recursive, or that share basic blocks, form one unit of work whose
+     *  functions are analyzed by a single thread in depth-first post-order; the other units are analyzed concurrently by up to
+     *  @p nThreads threads (zero means use the hardware concurrency) once all the units they call are finished. Progress is
+     *  reported on a progress bar named for the analysis and by calling @ref updateProgress with the @p name after each
+     *  function.
+     *
+     *  The analysis must be safe to call concurrently for functions in different units. The stack-delta, may-return,
+     *  calling-convention, and no-op analyses are driven this way.
+     *
+     *  Thread safety: Not thread safe. */
+    void forEachFunctionCalleesFirst(const std::string &name, const std::function<void(const Function::Ptr&)> &analysis,
+                                     size_t nThreads) const /*final*/;
+
     /** Stack delta analysis for one function.
      *
      *  Computes stack deltas if possible at each basic block within the specified function.  The algorithm starts at the
@@ -1970,6 +2012,8 @@ public:
     BaseSemantics::SValuePtr functionStackDelta(const Function::Ptr &function) const /*final*/;
 
     /** Compute stack delta analysis for all functions.
+     *
+     *  Functions are analyzed concurrently, callees before callers. See @ref forEachFunctionCalleesFirst.
      *
      *  Thread safety: Not thread safe. */
     void allFunctionStackDelta() const /*final*/;
@@ -1983,6 +2027,8 @@ public:
     Sawyer::Optional<bool> functionOptionalMayReturn(const Function::Ptr &function) const /*final*/;
 
     /** Compute may-return analysis for all functions.
+     *
+     *  Functions are analyzed concurrently, callees before callers. See @ref forEachFunctionCalleesFirst.
      *
      *  Thread safety: Not thread safe. */
     void allFunctionMayReturn() const /*final*/;
@@ -2530,10 +2576,10 @@ public:
 
     /** Obtain new RiscOperators.
      *
-     *  Creates a new instruction semantics infrastructure with a fresh machine state.  The partitioner supports two kinds of
-     *  memory state representations: list-based and map-based (see @ref semanticMemoryParadigm). If the memory paradigm is not
-     *  specified then the partitioner's default paradigm is used. Returns a null pointer if the architecture does not support
-     *  semantics.
+     *  Creates a new instruction semantics infrastructure with a fresh machine state.  The partitioner supports three kinds of
+     *  memory state representations: list-based, map-based, and indexed (see @ref semanticMemoryParadigm). If the memory
+     *  paradigm is not specified then the partitioner's default paradigm is used. Returns a null pointer if the architecture
+     *  does not support semantics.
      *
      *  Thread safety: Not thread safe.
      *
@@ -2595,6 +2641,18 @@ private:
     // Implementation for the discoverBasicBlock methods.  The startVa must not be the address of an existing placeholder.
     BasicBlock::Ptr discoverBasicBlockInternal(rose_addr_t startVa) const;
 
+    // Reconstruct a basic block from the basic block cache, or return null if the cache has no usable entry.
+    BasicBlock::Ptr discoverCachedBasicBlock(rose_addr_t startVa) const;
+
+    // Whether the CFG prevents a basic block from continuing at the specified successor address.
+    bool isBasicBlockStoppedByCfg(rose_addr_t startVa, const AddressUser &startVaOwners, rose_addr_t successorVa) const;
+
+    // Save a newly discovered basic block in the basic block cache.
+    void cacheBasicBlock(const BasicBlock::Ptr&, bool terminatedByContent) const;
+
+    // Context for basic block cache entries: architecture and settings that affect basic block discovery.
+    std::string basicBlockCacheContext() const;
+
     // This method is called whenever a new placeholder is inserted into the CFG or a new basic block is attached to the
     // CFG/AUM. The call happens immediately after the CFG/AUM are updated.
     void bblockAttached(const ControlFlowGraph::VertexIterator &newVertex);
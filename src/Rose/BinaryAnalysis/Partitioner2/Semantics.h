@@ -51,7 +51,7 @@ typedef InstructionSemantics2::BaseSemantics::StatePtr StatePtr;
  *  MemoryMap::INITIALIZED) obtains the data directly from the memory map.
  *
  *  Addresses for each read operation are saved in a list which is nominally reset at the beginning of each instruction. */
-template<class Super = InstructionSemantics2::SymbolicSemantics::MemoryListState> // or MemoryMapState
+template<class Super = InstructionSemantics2::SymbolicSemantics::MemoryListState> // or MemoryMapState or MemoryIndexedState
 class MemoryState: public Super {
 public:
     /** Shared-ownership pointer to a @ref MemoryState. See @ref heap_object_shared_ownership. */
@@ -60,6 +60,7 @@ public:
 private:
     MemoryMap::Ptr map_;
     std::vector<SValuePtr> addressesRead_;
+    AddressIntervalSet memoryMapRead_;
     bool enabled_;
 
 #ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
@@ -71,6 +72,7 @@ private:
         s & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Super);
         s & BOOST_SERIALIZATION_NVP(map_);
         s & BOOST_SERIALIZATION_NVP(addressesRead_);
+        s & BOOST_SERIALIZATION_NVP(memoryMapRead_);
         s & BOOST_SERIALIZATION_NVP(enabled_);
     }
 #endif
@@ -162,6 +164,16 @@ public:
     std::vector<SValuePtr>& addressesRead() { return addressesRead_; }
     /** @} */
 
+    /** Property: Addresses whose values were obtained from the memory map.
+     *
+     *  These are the bytes that were read from the memory map instead of from this state. Unlike @ref addressesRead, this is
+     *  not reset at the start of each instruction.
+     *
+     * @{ */
+    const AddressIntervalSet& memoryMapRead() const { return memoryMapRead_; }
+    AddressIntervalSet& memoryMapRead() { return memoryMapRead_; }
+    /** @} */
+
 public:
     virtual InstructionSemantics2::BaseSemantics::SValuePtr
     readMemory(const InstructionSemantics2::BaseSemantics::SValuePtr &addr,
@@ -199,12 +211,18 @@ typedef MemoryState<InstructionSemantics2::SymbolicSemantics::MemoryListState> M
 /** Memory state indexed by hash of address expressions. */
 typedef MemoryState<InstructionSemantics2::SymbolicSemantics::MemoryMapState> MemoryMapState;
 
+/** Memory state using a chronological list of cells that are also indexed by concrete address. */
+typedef MemoryState<InstructionSemantics2::SymbolicSemantics::MemoryIndexedState> MemoryIndexedState;
+
 /** Shared-ownership pointer to a @ref MemoryListState. See @ref heap_object_shared_ownership. */
 typedef boost::shared_ptr<MemoryListState> MemoryListStatePtr;
 
 /** Shared-ownership pointer to a @ref MemoryMapState. See @ref heap_object_shared_ownership. */
 typedef boost::shared_ptr<MemoryMapState> MemoryMapStatePtr;
 
+/** Shared-ownership pointer to a @ref MemoryIndexedState. See @ref heap_object_shared_ownership. */
+typedef boost::shared_ptr<MemoryIndexedState> MemoryIndexedStatePtr;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                      RISC Operators
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -272,6 +290,9 @@ public:
             case MAP_BASED_MEMORY:
                 memory = MemoryMapState::instance(protoval, protoval);
                 break;
+            case INDEXED_MEMORY:
+                memory = MemoryIndexedState::instance(protoval, protoval);
+                break;
         }
         InstructionSemantics2::BaseSemantics::StatePtr state = State::instance(registers, memory);
         return RiscOperatorsPtr(new RiscOperators(state, solver));
@@ -365,6 +386,7 @@ MemoryState<Super>::readOrPeekMemory(const InstructionSemantics2::BaseSemantics:
         if (!isModifiable || isInitialized) {
             uint8_t byte;
             if (1 == map_->at(va).limit(1).read(&byte).size()) {
+                memoryMapRead_.insert(AddressInterval(va));
                 SymbolicExpr::Ptr expr = SymbolicExpr::makeIntegerConstant(8, byte);
                 if (isModifiable) {
                     SymbolicExpr::Ptr indet = SymbolicExpr::makeIntegerVariable(8);
@@ -415,6 +437,7 @@ MemoryState<Super>::print(std::ostream &out, InstructionSemantics2::BaseSemantic
 #ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
 BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::Partitioner2::Semantics::MemoryListState);
 BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::Partitioner2::Semantics::MemoryMapState);
+BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::Partitioner2::Semantics::MemoryIndexedState);
 BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::Partitioner2::Semantics::RiscOperators);
 #endif
 
@@ -33,7 +33,9 @@
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/archive/xml_iarchive.hpp>
 #include <boost/archive/xml_oarchive.hpp>
+#include <boost/iostreams/device/array.hpp>
 #include <boost/iostreams/device/file_descriptor.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/iostreams/stream.hpp>
 #endif
 
@@ -41,6 +43,7 @@
 #include <Rose/Exception.h>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/thread.hpp>
 #include <Sawyer/Message.h>
 #include <Sawyer/ProgressBar.h>
@@ -70,6 +73,10 @@ class Partitioner;
  *  As objects are written to the output stream, they are each preceded by a object type identifier. These integer type
  *  identifiers are available when reading from the stream in order to decide which type of object to read next.
  *
+ *  The @ref MAPPED format is an exception to the sequential access. It must be written to a seekable file, and when it's read
+ *  the file is mapped into memory and each object is deserialized directly from the mapped pages. Each object is stored
+ *  separately and the file ends with an index, so objects that aren't needed can be skipped without reading them.
+ *
  *  I/O errors are reported by throwing an @ref Exception. Errors thrown by underlying layers, such as Boost, are caught
  *  and rethrown as @ref Exception in order to simplify this interface.
  *
@@ -125,8 +132,18 @@ public:
         TEXT,           /**< Textual binary state files use a custom format (Boost serialization format) that stores the
                          *   data as ASCII text. They are larger and slower than binary files but not as large and slow
                          *   as XML or JSON files. They are portable across architectures. */
-        XML             /**< The states are stored as XML, which is a very verbose and slow format. Avoid using this if
+        XML,            /**< The states are stored as XML, which is a very verbose and slow format. Avoid using this if
                          *   possible. */
+        MAPPED,         /**< Like @ref BINARY, except each object is stored separately and the file has an index. When
+                         *   reading, the file is mapped into memory and objects are deserialized only when they're
+                         *   requested, and may be skipped with @ref SerialInput::skipObject. Since objects are
+                         *   stored separately, sharing between two top-level objects (such as between a partitioner and an
+                         *   AST) is not preserved. The file cannot be written to or read from a pipe. */
+        COMPRESSED      /**< Like @ref BINARY, except the data is compressed. The stream is divided into chunks which are
+                         *   compressed or decompressed by worker threads (see the "--threads" switch) while the archive
+                         *   is being written or read. Files are typically several times smaller than binary files, and
+                         *   given enough threads are not much slower to write or read. This format is available
+                         *   only if ROSE was configured with zlib; see @ref supportsCompression. */
     };
 
     /** Types of objects that can be saved. */
@@ -164,6 +181,55 @@ protected:
     // so we use Boost.
     int fd_;
 
+#ifdef ROSE_SUPPORTS_SERIAL_IO
+    // Location of one object in a MAPPED file.
+    struct MappedObject {
+        uint64_t type;                                  // the Savable type
+        uint64_t offset;                                // offset of the object's archive from the beginning of the file
+        uint64_t size;                                  // size of the object's archive in bytes
+    };
+
+    // The end of a MAPPED file. The file begins with the same magic number.
+    struct MappedTrailer {
+        uint64_t indexOffset;                           // offset of the first MappedObject in the index
+        uint64_t nObjects;                              // number of objects in the index
+        char magic[8];
+    };
+
+    static const char mappedMagic[8];
+    static const char compressedMagic[8];
+
+    // Chunked compression and decompression for the COMPRESSED format using a pool of worker threads. These are defined in
+    // SerialIo.C.
+    class Compressor;
+    class Decompressor;
+
+    // Boost iostreams device that sends its data to a Compressor.
+    class CompressingSink {
+        boost::shared_ptr<Compressor> compressor_;
+    public:
+        typedef char char_type;
+        typedef boost::iostreams::sink_tag category;
+        explicit CompressingSink(const boost::shared_ptr<Compressor> &compressor)
+            : compressor_(compressor) {}
+        std::streamsize write(const char*, std::streamsize);
+    };
+
+    // Boost iostreams device that obtains its data from a Decompressor.
+    class DecompressingSource {
+        boost::shared_ptr<Decompressor> decompressor_;
+    public:
+        typedef char char_type;
+        typedef boost::iostreams::source_tag category;
+        explicit DecompressingSource(const boost::shared_ptr<Decompressor> &decompressor)
+            : decompressor_(decompressor) {}
+        std::streamsize read(char*, std::streamsize);
+    };
+
+    // Number of compression threads to use
+    static size_t nCompressionThreads();
+#endif
+
 protected:
     SerialIo()
         : format_(BINARY), progress_(Progress::instance()), isOpen_(false), objectType_(NO_OBJECT),
@@ -193,7 +259,7 @@ public:
     /** Property: File format.
      *
      *  This property specifies the file format of the data. It can only be set for output, and only before the output
-     *  file is opened.
+     *  file is opened. Setting it to @ref COMPRESSED throws an @ref Exception if compression is not supported.
      *
      *  Thread safety: This method is thread-safe.
      *
@@ -202,6 +268,12 @@ public:
     void format(Format);
     /** @} */
 
+    /** Whether the @ref COMPRESSED format is supported.
+     *
+     *  Compressed state files need zlib, which is detected when ROSE is configured. If it's not available then trying to use
+     *  the compressed format throws an @ref Exception. */
+    static bool supportsCompression();
+
     /** Property: Progress reporter.
      *
      *  A progress reporting object can be specified in which case the I/O operations will update this object. I/O objects are
@@ -280,6 +352,9 @@ private:
     boost::archive::binary_oarchive *binary_archive_;
     boost::archive::text_oarchive *text_archive_;
     boost::archive::xml_oarchive *xml_archive_;
+    std::vector<MappedObject> index_;                   // objects written so far in MAPPED format
+    boost::shared_ptr<Compressor> compressor_;          // for COMPRESSED format
+    boost::iostreams::stream<CompressingSink> compressed_; // uncompressed data for the COMPRESSED format
 #endif
 
 protected:
@@ -356,10 +431,13 @@ public:
         throw Exception("binary state files are not supported in this configuration");
 #elif defined(ROSE_DEBUG_SERIAL_IO)
         std::string errorMessage;
+        beginObject(objectTypeId);
         asyncSave(objectTypeId, object, &errorMessage);
+        endObject();
 #else
         // A different thread saves the object while this thread updates the progress
         std::string errorMessage;
+        beginObject(objectTypeId);
         boost::thread worker(startWorker<T>, this, objectTypeId, &object, &errorMessage);
         boost::chrono::milliseconds timeout((unsigned)(1000 * Sawyer::ProgressBarSettings::minimumUpdateInterval()));
         progressBar_.prefix("writing");
@@ -375,10 +453,16 @@ public:
         }
         if (!errorMessage.empty())
             throw Exception(errorMessage);
+        endObject();
 #endif
     }
 
 private:
+    // Prepare to write an object, and finish writing an object. These only do something for the MAPPED format, where each
+    // object is its own archive.
+    void beginObject(Savable objectTypeId);
+    void endObject();
+
     template<class T>
     static void startWorker(SerialOutput *saver, Savable objectTypeId, const T *object, std::string *errorMessage) {
         ASSERT_not_null(object);
@@ -398,6 +482,7 @@ private:
             objectType(ERROR);
             switch (format()) {
                 case BINARY:
+                case COMPRESSED:
                     ASSERT_not_null(binary_archive_);
                     *binary_archive_ <<BOOST_SERIALIZATION_NVP(objectTypeId);
                     *binary_archive_ <<BOOST_SERIALIZATION_NVP(object);
@@ -412,6 +497,11 @@ private:
                     *xml_archive_ <<BOOST_SERIALIZATION_NVP(objectTypeId);
                     *xml_archive_ <<BOOST_SERIALIZATION_NVP(object);
                     break;
+                case MAPPED:
+                    // The type is stored in the index instead of the archive
+                    ASSERT_not_null(binary_archive_);
+                    *binary_archive_ <<BOOST_SERIALIZATION_NVP(object);
+                    break;
             }
             objectType(objectTypeId);
 #if !defined(ROSE_DEBUG_SERIAL_IO)
@@ -445,18 +535,31 @@ private:
     boost::archive::binary_iarchive *binary_archive_;
     boost::archive::text_iarchive *text_archive_;
     boost::archive::xml_iarchive *xml_archive_;
+    boost::iostreams::mapped_file_source mapped_;       // entire file for MAPPED format
+    boost::iostreams::stream<boost::iostreams::array_source> object_; // current object within mapped_
+    std::vector<MappedObject> index_;                   // objects stored in a MAPPED file
+    size_t nextObject_;                                 // index of next object to read from a MAPPED file
+    boost::shared_ptr<Decompressor> decompressor_;      // for COMPRESSED format
+    boost::iostreams::stream<DecompressingSource> compressed_; // decompressed data for the COMPRESSED format
 #endif
 
 protected:
 #ifdef ROSE_SUPPORTS_SERIAL_IO
-    SerialInput(): fileSize_(0), binary_archive_(NULL), text_archive_(NULL), xml_archive_(NULL) {}
+    SerialInput(): fileSize_(0), binary_archive_(NULL), text_archive_(NULL), xml_archive_(NULL), nextObject_(0) {}
 #else
     SerialInput() {}
 #endif
 
 public:
     ~SerialInput();
+
+    /** Attach a file.
+     *
+     *  See @ref SerialIo::open. In addition, @ref MAPPED and @ref COMPRESSED state files are recognized by their contents and
+     *  the @ref format property is changed accordingly, except a compressed state read from standard input must be specified
+     *  by setting the @ref format property beforehand. */
     void open(const boost::filesystem::path &fileName) ROSE_OVERRIDE;
+
     void close() ROSE_OVERRIDE;
 
     /** Factory method to create a new instance.
@@ -474,6 +577,12 @@ public:
      * Thread safety: This method is not thread safe. */
     Savable nextObjectType();
 
+    /** Skip the next object.
+     *
+     *  Advances past the next object in the input without reading it. This is only possible for the @ref MAPPED format, where
+     *  it takes constant time. Throws an @ref Exception for other formats or if there is no next object. */
+    void skipObject();
+
     /** Load a partitioner from the input stream.
      *
      *  Initializes the specified partitioner with data from the input stream.
@@ -519,6 +628,7 @@ public:
         }
         objectType(ERROR); // in case of exception
         std::string errorMessage;
+        beginObject();
 #ifdef ROSE_DEBUG_SERIAL_IO
         asyncLoad(object, &errorMessage);
 #else
@@ -527,7 +637,7 @@ public:
         progressBar_.prefix("reading");
         while (!worker.try_join_for(timeout)) {
             if (fileSize_ > 0) {
-                off_t cur = ::lseek(fd_, 0, SEEK_CUR);
+                off_t cur = position();
                 if (cur != -1) {
                     progressBar_.value(cur);
                     if (Progress::Ptr p = progress())
@@ -540,12 +650,21 @@ public:
         if (!errorMessage.empty())
             throw Exception(errorMessage);
 #endif
+        endObject();
         advanceObjectType();
 #endif
     }
     /** @} */
         
 private:
+    // Prepare to read an object, and finish reading an object. These only do something for the MAPPED format, where each
+    // object is its own archive.
+    void beginObject();
+    void endObject();
+
+    // Approximate current position in the input file for progress reports, or -1 if unknown.
+    off_t position() const;
+
     template<class T>
     static void startWorker(SerialInput *loader, T *object, std::string *errorMessage) {
         loader->asyncLoad(*object, errorMessage);
@@ -563,6 +682,8 @@ private:
 #endif
             switch (format()) {
                 case BINARY:
+                case MAPPED:
+                case COMPRESSED:
                     ASSERT_not_null(binary_archive_);
                     *binary_archive_ >>object;
                     break;
@@ -588,6 +709,12 @@ private:
 protected:
     // Read the next object type from the input stream
     void advanceObjectType();
+
+private:
+#ifdef ROSE_SUPPORTS_SERIAL_IO
+    // Map a MAPPED file into memory and read its index.
+    void openMapped(const boost::filesystem::path&);
+#endif
 };
 
 } // namespace
@@ -52,6 +52,20 @@ protected:
     void operator()(const Sawyer::CommandLine::ParserResult&);
 };
 
+/** Opens an SMT memoization file from the command-line.
+ *
+ *  This is a Sawyer command-line switch action that opens or creates the file named by the "--smt-memoization=FILE" switch and
+ *  makes it the @ref SmtSolver::defaultMemoizationFile. An empty name means no memoization file. */
+class SmtMemoizationFileOpener: public Sawyer::CommandLine::SwitchAction {
+protected:
+    SmtMemoizationFileOpener() {}
+public:
+    typedef Sawyer::SharedPointer<SmtMemoizationFileOpener> Ptr;
+    static Ptr instance() { return Ptr(new SmtMemoizationFileOpener); }
+protected:
+    void operator()(const Sawyer::CommandLine::ParserResult&);
+};
+
 } // namespace
 } // namespace
 
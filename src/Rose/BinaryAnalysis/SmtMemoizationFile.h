@@ -0,0 +1,96 @@
+#ifndef ROSE_BinaryAnalysis_SmtMemoizationFile_H
+#define ROSE_BinaryAnalysis_SmtMemoizationFile_H
+#include <featureTests.h>
+#ifdef ROSE_ENABLE_BINARY_ANALYSIS
+
+#include <Rose/BinaryAnalysis/SmtSolver.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <Sawyer/Optional.h>
+
+namespace Rose {
+namespace BinaryAnalysis {
+
+/** Memoization table for SMT solvers that persists across runs.
+ *
+ *  The in-memory memoization table that belongs to each @ref SmtSolver disappears when the solver is destroyed. This class
+ *  is a second level of memoization stored in a file that's mapped into memory so that a satisfiability question answered
+ *  by one run of a tool doesn't need to be answered again by a later run. A single table is normally shared by all solvers
+ *  (see @ref SmtSolver::defaultMemoizationFile), and it can be used concurrently by multiple threads.
+ *
+ *  The table is keyed by the hash of the solver's normalized assertions (see @ref SmtSolver::latestMemoizationId) and has a
+ *  fixed capacity chosen when the file is created. Entries are grouped into small sets and when a set is full the least
+ *  recently used entry of that set is evicted, so the file never grows.
+ *
+ *  More than one process may use the same file at the same time. Entries are not locked across processes, but each entry has
+ *  a check word, and an entry that is only partly written is treated as if it were empty. */
+class SmtMemoizationFile: private boost::noncopyable {
+public:
+    /** Reference counting pointer. */
+    using Ptr = SmtMemoizationFilePtr;
+
+    /** Number of entries in each set. */
+    static const size_t associativity = 8;
+
+private:
+    struct Header;
+    struct Entry;
+
+    boost::filesystem::path name_;
+    mutable boost::mutex mutex_;                        // protects all following data members and the file contents
+    boost::iostreams::mapped_file file_;
+    Header *header_;                                    // first part of the mapped file
+    Entry *entries_;                                    // the table, immediately following the header
+    size_t nSets_;                                      // number of sets, each having "associativity" entries
+
+protected:
+    // Reference counted. Use instance() instead.
+    SmtMemoizationFile(const boost::filesystem::path&, size_t nEntries);
+
+public:
+    ~SmtMemoizationFile();
+
+    /** Open or create a memoization file.
+     *
+     *  If the file exists then it is opened and its existing capacity is used. Otherwise a new, empty file is created that can
+     *  hold about @p nEntries entries. Each entry occupies 24 bytes. Throws an @ref SmtSolver::Exception if the file exists but
+     *  is not a memoization file. */
+    static Ptr instance(const boost::filesystem::path &fileName, size_t nEntries = 1024*1024);
+
+    /** Name of the file. */
+    const boost::filesystem::path& name() const {
+        return name_;
+    }
+
+    /** Maximum number of entries. */
+    size_t capacity() const;
+
+    /** Number of entries currently stored.
+     *
+     *  This requires a scan of the entire table. */
+    size_t size() const;
+
+    /** Look up a previous result.
+     *
+     *  Returns the memoized result for the specified hash, or nothing if no result is memoized. A successful look-up marks the
+     *  entry as recently used. */
+    Sawyer::Optional<SmtSolver::Satisfiable> find(SymbolicExpr::Hash);
+
+    /** Insert or replace a result. */
+    void insert(SymbolicExpr::Hash, SmtSolver::Satisfiable);
+
+    /** Remove all entries. */
+    void clear();
+
+private:
+    void initFile();
+};
+
+} // namespace
+} // namespace
+
+#endif
+#endif
@@ -24,6 +24,9 @@ namespace BinaryAnalysis {
 /** Reference-counting pointer for SMT solvers. */
 using SmtSolverPtr = std::shared_ptr<class SmtSolver>;
 
+/** Reference-counting pointer for SMT memoization files. */
+using SmtMemoizationFilePtr = std::shared_ptr<class SmtMemoizationFile>;
+
 class CompareLeavesByName {
 public:
     bool operator()(const SymbolicExpr::LeafPtr&, const SymbolicExpr::LeafPtr&) const;
@@ -92,6 +95,7 @@ public:
         size_t input_size;                              /**< Bytes of input generated for satisfiable(). */
         size_t output_size;                             /**< Amount of output produced by the SMT solver. */
         size_t memoizationHits;                         /**< Number of times memoization supplied a result. */
+        size_t memoizationFileHits;                     /**< Number of times a memoization file supplied a result. */
         size_t nSolversCreated;                         /**< Number of solvers created. Only for class statistics. */
         size_t nSolversDestroyed;                       /**< Number of solvers destroyed. Only for class statistics. */
         double prepareTime;                             /**< Time spent creating assertions before solving. */
@@ -103,8 +107,9 @@ public:
         // Remember to add all data members to resetStatistics()
 
         Stats()
-            : ncalls(0), input_size(0), output_size(0), memoizationHits(0), nSolversCreated(0), nSolversDestroyed(0),
-              prepareTime(0.0), solveTime(0.0), evidenceTime(0.0), nSatisfied(0), nUnsatisfied(0), nUnknown(0) {
+            : ncalls(0), input_size(0), output_size(0), memoizationHits(0), memoizationFileHits(0), nSolversCreated(0),
+              nSolversDestroyed(0), prepareTime(0.0), solveTime(0.0), evidenceTime(0.0), nSatisfied(0), nUnsatisfied(0),
+              nUnknown(0) {
         }
     };
 
@@ -211,10 +216,12 @@ protected:
     bool doMemoization_;                                // use the memoization_ table?
     Sawyer::Optional<SymbolicExpr::Hash> latestMemoizationId_; // key for last found or inserted memoization, or nothing
     SymbolicExpr::ExprExprHashMap latestMemoizationRewrite_; // variables rewritten, need to be undone when parsing evidence
+    SmtMemoizationFilePtr memoizationFile_;             // optional memoization that persists across runs
 
     // Statistics
     static boost::mutex classStatsMutex;
     static Stats classStats;                            // all access must be protected by classStatsMutex
+    static SmtMemoizationFilePtr classMemoizationFile;  // all access must be protected by classStatsMutex
     Stats stats;
 
 public:
@@ -238,6 +245,7 @@ private:
         // doMemoization_            -- not serialized
         // latestMemoizationId_      -- not serialized
         // latestMemoizationRewrite_ -- not serialized
+        // memoizationFile_          -- not serialized
         // classStatsMutex           -- not serialized
         // classStats                -- not serialized
         // stats                     -- not serialized
@@ -346,6 +354,32 @@ public:
         return memoization_.size();
     }
 
+    /** Property: Memoization file.
+     *
+     *  If non-null, then unsatisfiable results are also memoized in this file, and the file is consulted when a result is not
+     *  found in the solver's own memoization table. Unlike the solver's own table, the file can be shared with other solvers
+     *  and it persists across runs. Only unsatisfiable results are stored in the file since satisfiable results would need
+     *  their evidence, and unknown results usually depend on the solver's timeout. The file is not used when the @ref
+     *  memoization property is clear.
+     *
+     *  Solvers are initialized with the @ref defaultMemoizationFile.
+     *
+     * @{ */
+    SmtMemoizationFilePtr memoizationFile() const { return memoizationFile_; }
+    void memoizationFile(const SmtMemoizationFilePtr &f) { memoizationFile_ = f; }
+    /** @} */
+
+    /** Property: Default memoization file.
+     *
+     *  This is the memoization file given to each solver when it's constructed. The default is null.
+     *
+     *  Thread safety: This class method is thread safe.
+     *
+     * @{ */
+    static SmtMemoizationFilePtr defaultMemoizationFile();
+    static void defaultMemoizationFile(const SmtMemoizationFilePtr&);
+    /** @} */
+
     /** Set the timeout for the solver.
      *
      *  This sets the maximum time that the solver will try to find a solution before returning "unknown". */
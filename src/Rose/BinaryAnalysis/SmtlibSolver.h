@@ -6,16 +6,31 @@
 #include <Rose/BinaryAnalysis/SmtSolver.h>
 #include <boost/filesystem.hpp>
 #include <boost/unordered_map.hpp>
+#include <set>
 
 namespace Rose {
 namespace BinaryAnalysis {
 
 /** Wrapper around solvers that speak SMT-LIB. */
 class SmtlibSolver: public SmtSolver {
+protected:
+    /** Information about one backtracking level of a persistent solver process. */
+    struct PersistentLevel {
+        std::vector<SymbolicExpr::Ptr> assertions;      /**< Assertions already sent to the process at this level. */
+        std::set<std::string> definitions;              /**< Names declared or defined by the process at this level. */
+    };
+
 private:
     boost::filesystem::path executable_;                // solver program
     std::string shellArgs_;                             // extra arguments for command (passed through shell)
     ExprExprMap varsForSets_;                           // variables to use for sets
+    size_t nCses_;                                      // number of common subexpression names generated so far
+    bool persistent_;                                   // use one long-lived solver process for all checks?
+    int persistentFd_;                                  // our end of the socket connected to the solver process, or -1
+    int persistentPid_;                                 // process ID of the persistent solver process, or -1
+    std::string persistentCommand_;                     // command that started the persistent solver process
+    std::string persistentBuffer_;                      // text read from the solver process but not yet consumed
+    std::vector<PersistentLevel> persistentLevels_;     // levels that have been pushed in the solver process
 
 protected:
     ExprExprMap evidence;
@@ -27,9 +42,12 @@ protected:
     // Reference counted. Use instance() or create() instead.
     explicit SmtlibSolver(const std::string &name, const boost::filesystem::path &executable, const std::string &shellArgs = "",
                           unsigned linkages = LM_EXECUTABLE)
-        : SmtSolver(name, linkages), executable_(executable), shellArgs_(shellArgs) {}
+        : SmtSolver(name, linkages), executable_(executable), shellArgs_(shellArgs), nCses_(0), persistent_(false),
+          persistentFd_(-1), persistentPid_(-1) {}
 
 public:
+    ~SmtlibSolver();
+
     /** Construct a solver using the specified program.
      *
      *  This object will communicate with the SMT solver using SMT-LIB version 2 text files, both for input to the solver and
@@ -50,9 +68,27 @@ public:
      *
      *  Creates a new solver like this one. */
     virtual Ptr create() const ROSE_OVERRIDE {
-        return instance(name(), executable_, shellArgs_, linkage());
+        Ptr retval = instance(name(), executable_, shellArgs_, linkage());
+        static_cast<SmtlibSolver*>(retval.get())->persistent(persistent());
+        return retval;
     }
-    
+
+    /** Property: Use a persistent solver process.
+     *
+     *  When this property is set and the solver uses executable linkage, a single solver process is started the first time a
+     *  satisfiability check is needed and it continues to run until this solver is destroyed or the property is cleared.
+     *  Each check is sent to this process over a pipe instead of writing a temporary file and running a new process. The
+     *  backtracking levels of this solver (see @ref push, @ref pop, and @ref Transaction) are mirrored in the solver process
+     *  with SMT-LIB "push" and "pop" commands so that only those assertions that the process hasn't seen yet need to be
+     *  sent. If the solver process fails then an exception is thrown and a new process is started for the next check.
+     *
+     *  This property is ignored for solvers that don't use executable linkage.
+     *
+     * @{ */
+    bool persistent() const { return persistent_; }
+    virtual void persistent(bool);
+    /** @} */
+
 public:
     virtual void reset() ROSE_OVERRIDE;
     virtual void generateFile(std::ostream&, const std::vector<SymbolicExpr::Ptr> &exprs, Definitions*) ROSE_OVERRIDE;
@@ -65,7 +101,29 @@ public:
     virtual void clearMemoization() ROSE_OVERRIDE;
     virtual void timeout(boost::chrono::duration<double>) ROSE_OVERRIDE;
 
+    /** Command to start a persistent solver process.
+     *
+     *  Returns the shell command that starts a solver which reads SMT-LIB commands from its standard input and writes its
+     *  responses to its standard output. The default is the solver executable and its shell arguments followed by "-in",
+     *  which is how Z3 is told to read standard input. */
+    virtual std::string getPersistentCommand();
+
 protected:
+    virtual Satisfiable checkExe() ROSE_OVERRIDE;
+
+    /** Check satisfiability using a persistent solver process.
+     *
+     *  This is the @ref checkExe implementation used when the @ref persistent property is set. */
+    virtual Satisfiable checkPersistent();
+
+    /** Generate input for a persistent solver process.
+     *
+     *  Emits SMT-LIB commands that declare and define whatever the specified assertions need and which is not already
+     *  declared or defined by the process according to @p levels, followed by the assertions themselves. The names of the
+     *  new declarations and definitions are added to the last level. */
+    virtual void generateIncrement(std::ostream&, const std::vector<SymbolicExpr::Ptr> &exprs,
+                                   std::vector<PersistentLevel> &levels /*in,out*/);
+
     /** Specify variable to use for OP_SET.
      *
      *  Each OP_SET needs a free variable to choose from the available members of the set.  This function sets (two arguments)
@@ -171,6 +229,12 @@ protected:
     virtual void outputComments(std::ostream&, const std::vector<SymbolicExpr::Ptr>&);
     virtual void outputCommonSubexpressions(std::ostream&, const std::vector<SymbolicExpr::Ptr>&);
     virtual void outputAssertion(std::ostream&, const SymbolicExpr::Ptr&);
+
+private:
+    void startPersistent();
+    void stopPersistent();
+    void sendPersistent(const std::string&);
+    std::string receivePersistent(const std::string &marker);
 };
 
 } // namespace
@@ -973,6 +973,226 @@ public:
 
 std::ostream& operator<<(std::ostream&, const StringFinder&);
 
+/** %Analysis to quickly find runs of printable characters.
+ *
+ *  This analysis finds the same kind of strings as the Unix strings(1) command: maximal runs of printable characters, each
+ *  optionally followed by a NUL terminator. It is much less general than the @ref StringFinder, which can find length-encoded
+ *  strings and strings in arbitrary encodings, but it is much faster when searching large memory images because it doesn't
+ *  run a decoder state machine for each encoding at each address. Instead, bytes are classified directly (printable ASCII is
+ *  tested eight bytes at a time), memory is divided into chunks that are scanned in parallel, and only those strings that are
+ *  found are decoded.
+ *
+ *  The results are @ref EncodedString objects whose encoders are the same kinds as those created by @ref
+ *  nulTerminatedPrintableAscii and @ref nulTerminatedPrintableAsciiWide, so they can be used wherever the results of a @ref
+ *  StringFinder are used. A string that is followed by a NUL character includes the NUL in its @ref EncodedString::where
+ *  "location" and uses a terminated encoder; other strings use an encoder with no terminators.
+ *
+ *  Example: find NUL-terminated or unterminated printable ASCII and UTF-16 strings in all readable memory:
+ *
+ * @code
+ *  using namespace Rose::BinaryAnalysis::Strings;
+ *  PrintableRunFinder finder;
+ *  finder.settings().findingUtf16 = true;
+ *  std::vector<EncodedString> strings = finder.find(map->require(MemoryMap::READABLE)).strings();
+ * @endcode */
+class ROSE_DLL_API PrintableRunFinder {
+public:
+    /** Settings and properties. */
+    struct Settings {
+        /** Minimum length of matched strings.
+         *
+         *  Strings having fewer than this many code points are discarded. The NUL terminator is not counted. */
+        size_t minLength;
+
+        /** Maximum length of matched strings.
+         *
+         *  Strings having more than this many code points are discarded. The NUL terminator is not counted. */
+        size_t maxLength;
+
+        /** Whether to find runs of printable ASCII stored one character per byte. */
+        bool findingAscii;
+
+        /** Whether to find runs of printable UTF-8.
+         *
+         *  A UTF-8 string must contain at least one multi-byte character, since runs of only ASCII characters are found by
+         *  the @ref findingAscii setting. Characters can be any Unicode code point at or above U+00A0, or printable ASCII. */
+        bool findingUtf8;
+
+        /** Whether to find runs of printable ASCII stored as 16-bit code values.
+         *
+         *  This is the encoding that compilers use for wide strings of ASCII characters on Microsoft Windows. Strings may
+         *  start at even or odd addresses. See also @ref utf16ByteOrder. */
+        bool findingUtf16;
+
+        /** Byte order for 16-bit code values. */
+        ByteOrder::Endianness utf16ByteOrder;
+
+        /** Whether to keep only longest non-overlapping strings.
+         *
+         *  If set, then the strings are sorted by decreasing length and any string that overlaps with a prior string in the
+         *  list is removed. This removes, for instance, short ASCII strings that overlap with longer UTF-8 strings. */
+        bool keepingOnlyLongest;
+
+        Settings()
+            : minLength(5), maxLength(-1), findingAscii(true), findingUtf8(false), findingUtf16(false),
+              utf16ByteOrder(ByteOrder::ORDER_LSB), keepingOnlyLongest(true) {}
+    };
+
+private:
+    Settings settings_;                                 // settings for this analysis
+    bool discardingCodePoints_;                         // whether to store decoded code points
+    size_t nThreads_;                                   // number of threads; zero means use the global setting
+    size_t chunkSize_;                                  // number of bytes scanned by each parallel task
+    std::vector<EncodedString> strings_;                // strings that have been found
+
+public:
+    /** Constructor.
+     *
+     *  Initializes the analysis to find NUL-terminated and unterminated printable ASCII strings. */
+    PrintableRunFinder(): discardingCodePoints_(false), nThreads_(0), chunkSize_(1024*1024) {}
+
+    /** Property: %Analysis settings.
+     *
+     * @{ */
+    const Settings& settings() const { return settings_; }
+    Settings& settings() { return settings_; }
+    /** @} */
+
+    /** Property: Whether to discard code points.
+     *
+     *  See @ref StringFinder::discardingCodePoints.
+     *
+     * @{ */
+    bool discardingCodePoints() const { return discardingCodePoints_; }
+    PrintableRunFinder& discardingCodePoints(bool b) { discardingCodePoints_ = b; return *this; }
+    /** @} */
+
+    /** Property: Number of threads.
+     *
+     *  If zero, then the number of threads comes from the global "--threads" command-line switch, and if that is also zero
+     *  then the hardware concurrency is used.
+     *
+     * @{ */
+    size_t nThreads() const { return nThreads_; }
+    PrintableRunFinder& nThreads(size_t n) { nThreads_ = n; return *this; }
+    /** @} */
+
+    /** Property: Number of bytes scanned by each parallel task.
+     *
+     *  Memory is divided into chunks of this size that are scanned independently, and strings that cross chunk boundaries
+     *  are joined afterward. The results don't depend on this property. Zero is treated as one.
+     *
+     * @{ */
+    size_t chunkSize() const { return chunkSize_; }
+    PrintableRunFinder& chunkSize(size_t n) { chunkSize_ = n; return *this; }
+    /** @} */
+
+    /** Reset analysis results.
+     *
+     *  Clears analysis results but does not change settings or properties. */
+    PrintableRunFinder& reset() { strings_.clear(); return *this; }
+
+    /** Finds strings by searching memory.
+     *
+     *  Clears previous analysis results (e.g., @ref reset) and then searches the memory described by the constraints. Memory
+     *  that is contiguous in the constrained map is searched as one region, so strings can span segment boundaries. The
+     *  resulting strings, sorted by address, can be obtained from the @ref strings method. */
+    PrintableRunFinder& find(const MemoryMap::ConstConstraints&, Sawyer::Container::MatchFlags flags=0);
+
+    /** Obtain strings that were found.
+     *
+     * @{ */
+    const std::vector<EncodedString>& strings() const { return strings_; }
+    std::vector<EncodedString>& strings() { return strings_; }
+    /** @} */
+
+    /** Print results.
+     *
+     *  Print information about each string, one string per line.  Strings are displayed with C/C++ string syntax. */
+    std::ostream& print(std::ostream&) const;
+};
+
+std::ostream& operator<<(std::ostream&, const PrintableRunFinder&);
+
+/** %Analysis to find many byte patterns at once.
+ *
+ *  This analysis searches memory for any number of byte sequences, such as known constants or string literals, in a single
+ *  pass. The patterns are indexed by their first byte so that each address is compared with only those patterns that could
+ *  match there, and memory is divided into chunks that are searched in parallel. */
+class ROSE_DLL_API PatternFinder {
+public:
+    /** One occurrence of a pattern. */
+    struct Match {
+        size_t pattern;                                 /**< Index of the pattern in the @ref patterns list. */
+        rose_addr_t address;                            /**< Address of the first byte of the occurrence. */
+
+        Match()
+            : pattern(0), address(0) {}
+        Match(size_t idx, rose_addr_t va)
+            : pattern(idx), address(va) {}
+    };
+
+private:
+    std::vector<Octets> patterns_;                      // patterns to find
+    size_t nThreads_;                                   // number of threads; zero means use the global setting
+    size_t chunkSize_;                                  // number of addresses searched by each parallel task
+    std::vector<Match> matches_;                        // occurrences that have been found
+
+public:
+    PatternFinder(): nThreads_(0), chunkSize_(1024*1024) {}
+
+    /** Add a pattern.
+     *
+     *  Returns the index of the new pattern, which is used in the @ref Match results. Patterns must not be empty. */
+    size_t insert(const Octets &pattern);
+
+    /** Add the octets of a string as a pattern.
+     *
+     *  The pattern does not include a NUL terminator. */
+    size_t insert(const std::string &pattern);
+
+    /** Patterns to find. */
+    const std::vector<Octets>& patterns() const { return patterns_; }
+
+    /** Remove all patterns and results. */
+    PatternFinder& clear() { patterns_.clear(); matches_.clear(); return *this; }
+
+    /** Property: Number of threads.
+     *
+     *  If zero, then the number of threads comes from the global "--threads" command-line switch, and if that is also zero
+     *  then the hardware concurrency is used.
+     *
+     * @{ */
+    size_t nThreads() const { return nThreads_; }
+    PatternFinder& nThreads(size_t n) { nThreads_ = n; return *this; }
+    /** @} */
+
+    /** Property: Number of addresses searched by each parallel task.
+     *
+     *  The results don't depend on this property. Zero is treated as one.
+     *
+     * @{ */
+    size_t chunkSize() const { return chunkSize_; }
+    PatternFinder& chunkSize(size_t n) { chunkSize_ = n; return *this; }
+    /** @} */
+
+    /** Reset analysis results.
+     *
+     *  Clears analysis results but does not remove patterns. */
+    PatternFinder& reset() { matches_.clear(); return *this; }
+
+    /** Finds patterns by searching memory.
+     *
+     *  Clears previous results and then searches the memory described by the constraints. Occurrences may overlap one
+     *  another and may span segment boundaries if the memory is contiguous. */
+    PatternFinder& find(const MemoryMap::ConstConstraints&, Sawyer::Container::MatchFlags flags=0);
+
+    /** Occurrences that were found.
+     *
+     *  The occurrences are sorted by address, and by pattern index for occurrences at the same address. */
+    const std::vector<Match>& matches() const { return matches_; }
+};
+
 } // namespace
 } // namespace
 } // namespace
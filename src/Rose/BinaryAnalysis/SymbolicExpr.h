@@ -154,6 +154,7 @@ class Node;
 class Interior;
 class Leaf;
 class ExprExprHashMap;
+class InterningTable;
 
 /** Shared-ownership pointer to an expression @ref Node. See @ref heap_object_shared_ownership. */
 typedef Sawyer::SharedPointer<Node> Ptr;
@@ -471,6 +472,10 @@ protected:
     Hash hashval_;                    /**< Optional hash used as a quick way to indicate that two expressions are different. */
     boost::any userData_;             /**< Additional user-specified data. This is not part of the hash. */
 
+private:
+    friend class InterningTable;
+    bool interned_;                   // node is present in the interning table; see SymbolicExpr::intern
+
 #ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
 private:
     friend class boost::serialization::access;
@@ -508,9 +513,9 @@ public:
 
 protected:
     Node()
-        : type_(Type::integer(0)), flags_(0), hashval_(0) {}
+        : type_(Type::integer(0)), flags_(0), hashval_(0), interned_(false) {}
     explicit Node(const std::string &comment, unsigned flags=0)
-        : type_(Type::integer(0)), flags_(flags), comment_(comment), hashval_(0) {}
+        : type_(Type::integer(0)), flags_(flags), comment_(comment), hashval_(0), interned_(false) {}
 
 public:
     /** Type of value. */
@@ -694,15 +699,28 @@ public:
      *  expressions. Changing the comment property is allowed even though nodes are generally immutable because comments are
      *  not considered significant for comparisons, computing hash values, etc.
      *
+     *  The comment of an interned node cannot be changed since the node might be shared by unrelated expressions (see @ref
+     *  intern). Use @ref withComment instead.
+     *
      * @{ */
     const std::string& comment() const {
         return comment_;
     }
     void comment(const std::string &s) {
-        comment_ = s;
+        if (s != comment_) {
+            ASSERT_forbid2(interned_, "the comment of an interned node cannot be changed; see withComment");
+            comment_ = s;
+        }
     }
     /** @} */
 
+    /** Expression with a different comment.
+     *
+     *  Returns this node if it already has the specified comment, otherwise returns a new node that's the same as this one
+     *  except for its comment. The new node is not interned, and it shares its children with this node. Unlike changing the
+     *  comment property, this does not affect other expressions that share this node. */
+    virtual Ptr withComment(const std::string&) = 0;
+
     /** Property: User-defined data.
      *
      *  User defined data is always optional and does not contribute to the hash value of an expression. The user-defined data
@@ -805,6 +823,13 @@ public:
     // used internally to set the hash value
     void hash(Hash);
 
+    /** Returns true if this node is interned.
+     *
+     *  An interned node is the only interned node that has its particular structure and flags. See @ref intern. */
+    bool isInterned() const {
+        return interned_;
+    }
+
     /** A node with formatter. See the with_format() method. */
     class WithFormatter {
     private:
@@ -1117,6 +1142,7 @@ public:
     virtual bool mustEqual(const Ptr &other, const SmtSolverPtr &solver = SmtSolverPtr()) ROSE_OVERRIDE;
     virtual bool mayEqual(const Ptr &other, const SmtSolverPtr &solver = SmtSolverPtr()) ROSE_OVERRIDE;
     virtual bool isEquivalentTo(const Ptr &other) ROSE_OVERRIDE;
+    virtual Ptr withComment(const std::string&) ROSE_OVERRIDE;
     virtual int compareStructure(const Ptr& other) ROSE_OVERRIDE;
     virtual Ptr substitute(const Ptr &from, const Ptr &to, const SmtSolverPtr &solver = SmtSolverPtr()) ROSE_OVERRIDE;
     virtual VisitAction depthFirstTraversal(Visitor&) const ROSE_OVERRIDE;
@@ -1284,6 +1310,7 @@ public:
     virtual bool mustEqual(const Ptr &other, const SmtSolverPtr &solver = SmtSolverPtr()) ROSE_OVERRIDE;
     virtual bool mayEqual(const Ptr &other, const SmtSolverPtr &solver = SmtSolverPtr()) ROSE_OVERRIDE;
     virtual bool isEquivalentTo(const Ptr &other) ROSE_OVERRIDE;
+    virtual Ptr withComment(const std::string&) ROSE_OVERRIDE;
     virtual int compareStructure(const Ptr& other) ROSE_OVERRIDE;
     virtual Ptr substitute(const Ptr &from, const Ptr &to, const SmtSolverPtr &solver = SmtSolverPtr()) ROSE_OVERRIDE;
     virtual VisitAction depthFirstTraversal(Visitor&) const ROSE_OVERRIDE;
@@ -1344,6 +1371,56 @@ private:
     static uint64_t nextNameCounter(uint64_t useThis = (uint64_t)(-1));
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Interning
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Property: Whether newly created expressions are interned.
+ *
+ *  When interning is enabled, the @ref Interior::instance and @ref Leaf creation functions pass each new node through @ref
+ *  intern so that structurally identical expressions share a single node. This reduces the memory used by large symbolic
+ *  states and turns most equivalence tests between interned nodes into pointer comparisons. Interning is disabled by default.
+ *  Disabling it does not remove any nodes from the table; see @ref clearInterning.
+ *
+ * @{ */
+bool interning();
+void interning(bool);
+/** @} */
+
+/** Intern an expression.
+ *
+ *  Returns the interned node that is equivalent to the specified node and has the same type and flags. If there is no such node
+ *  then the specified node itself becomes interned and is returned. Children of interior nodes are compared for equivalence
+ *  only, thus the returned expression may have different comments deeper in its tree.
+ *
+ *  Comments are kept out of the table: a node that has a comment is returned as is, without being interned, and the comment of
+ *  an interned node cannot be changed (see @ref Node::withComment). Variables created with a new ID are unique and are never
+ *  interned by the @ref Leaf creation functions.
+ *
+ *  The interning table is shared by all threads. It is divided into shards each with its own lock, and it holds a reference to
+ *  every interned node. Nodes are added to and removed from the table only while holding the lock of their shard. Nodes that
+ *  are referenced only by the table are released from time to time. */
+Ptr intern(const Ptr&);
+
+/** Statistics about the interning table. */
+struct InterningStats {
+    size_t nLookups;                                    /**< Number of calls to @ref intern that searched the table. */
+    size_t nHits;                                       /**< Number of searches that found an existing node. */
+    size_t nEntries;                                    /**< Number of nodes currently held by the table. */
+
+    InterningStats()
+        : nLookups(0), nHits(0), nEntries(0) {}
+};
+
+/** Statistics about the interning table. */
+InterningStats interningStatistics();
+
+/** Remove all nodes from the interning table.
+ *
+ *  The nodes themselves continue to exist as long as they're referenced elsewhere, but they're no longer interned. The
+ *  statistics are also reset. This must not be called while other threads are using interned expressions. */
+void clearInterning();
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                      Factories
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
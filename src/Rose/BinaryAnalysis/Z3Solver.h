@@ -98,7 +98,9 @@ public:
      *
      *  Create a new solver just like this one. */
     virtual Ptr create() const ROSE_OVERRIDE {
-        return Ptr(instance(linkage()));
+        Z3Solver *retval = new Z3Solver(linkage());
+        retval->persistent(persistent());
+        return Ptr(retval);
     }
 
     /** Construct Z3 solver using a specified executable.
@@ -140,6 +140,8 @@ struct GenericSwitchArgs {
                                                          *   message and exit with a failure status. When this data member is
                                                          *   false, then the tool will silently exit with success, which is
                                                          *   useful during "make check" or similar testing. */
+    std::string smtMemoizationFile;                     /**< Name of file used to memoize SMT solver results across runs. The
+                                                         *   empty string means results are not memoized across runs. */
     Color::Colorization colorization;                   /**< Controls colorized output. */
 
     GenericSwitchArgs()
@@ -3,6 +3,9 @@
 
 #include <boost/cstdint.hpp>
 #include <Sawyer/Graph.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 namespace Rose {
 
@@ -73,6 +76,102 @@ deserialize(std::istream &input, Graph &graph)
     }
 }
 
+/** Find strongly connected components.
+ *
+ *  Partitions the vertices of a graph into strongly connected components using Tarjan's algorithm, and returns the number of
+ *  components. On return, @p components is indexed by vertex ID and holds the component number for each vertex. Components
+ *  are numbered in topological order: if an edge goes from a vertex in component @em a to a vertex in a different component
+ *  @em b then @em a is less than @em b.
+ *
+ *  The depth-first search starts at the @p roots in the order given, then at vertices that have no incoming edges, and then at
+ *  any vertices still not visited, in order of vertex ID. If @p postorder is not null then it's filled with the post-order
+ *  number of each vertex from that search, indexed by vertex ID. Sorting the vertices of a component by decreasing post-order
+ *  number gives a reverse post-order for the component.
+ *
+ *  The search is not recursive, so it works for graphs with very long paths. */
+template<class Graph>
+size_t
+findStronglyConnectedComponents(const Graph &graph, std::vector<size_t> &components /*out*/,
+                                const std::vector<size_t> &roots = std::vector<size_t>(),
+                                std::vector<size_t> *postorder /*out*/ = NULL) {
+    typedef typename Graph::ConstVertexIterator VertexIter;
+    typedef typename Graph::ConstEdgeIterator EdgeIter;
+    const size_t nVertices = graph.nVertices();
+    const size_t UNVISITED = (size_t)(-1);
+    std::vector<size_t> preorder(nVertices, UNVISITED), lowLink(nVertices, 0);
+    std::vector<bool> onStack(nVertices, false);
+    std::vector<size_t> componentStack;
+    std::vector<std::pair<VertexIter, EdgeIter> > dfsStack;
+    size_t nPreorder = 0, nPostorder = 0, nComponents = 0;
+    components.clear();
+    components.resize(nVertices, UNVISITED);
+    if (postorder) {
+        postorder->clear();
+        postorder->resize(nVertices, 0);
+    }
+
+    std::vector<size_t> allRoots = roots;
+    for (size_t pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0; i < nVertices; ++i) {
+            if ((0 == pass) == (0 == graph.findVertex(i)->nInEdges()))
+                allRoots.push_back(i);
+        }
+    }
+
+    for (size_t r = 0; r < allRoots.size(); ++r) {
+        size_t root = allRoots[r];
+        ASSERT_require(root < nVertices);
+        if (preorder[root] != UNVISITED)
+            continue;
+        VertexIter rootVertex = graph.findVertex(root);
+        preorder[root] = lowLink[root] = nPreorder++;
+        componentStack.push_back(root);
+        onStack[root] = true;
+        dfsStack.push_back(std::make_pair(rootVertex, rootVertex->outEdges().begin()));
+
+        while (!dfsStack.empty()) {
+            VertexIter vertex = dfsStack.back().first;
+            size_t v = vertex->id();
+            if (dfsStack.back().second != vertex->outEdges().end()) {
+                VertexIter target = dfsStack.back().second->target();
+                ++dfsStack.back().second;
+                size_t w = target->id();
+                if (UNVISITED == preorder[w]) {
+                    preorder[w] = lowLink[w] = nPreorder++;
+                    componentStack.push_back(w);
+                    onStack[w] = true;
+                    dfsStack.push_back(std::make_pair(target, target->outEdges().begin()));
+                } else if (onStack[w]) {
+                    lowLink[v] = std::min(lowLink[v], preorder[w]);
+                }
+            } else {
+                dfsStack.pop_back();
+                if (postorder)
+                    (*postorder)[v] = nPostorder++;
+                if (!dfsStack.empty()) {
+                    size_t parent = dfsStack.back().first->id();
+                    lowLink[parent] = std::min(lowLink[parent], lowLink[v]);
+                }
+                if (lowLink[v] == preorder[v]) {
+                    size_t w = UNVISITED;
+                    do {
+                        w = componentStack.back();
+                        componentStack.pop_back();
+                        onStack[w] = false;
+                        components[w] = nComponents;
+                    } while (w != v);
+                    ++nComponents;
+                }
+            }
+        }
+    }
+
+    // Tarjan's algorithm finds the components in reverse topological order.
+    for (size_t i = 0; i < nVertices; ++i)
+        components[i] = nComponents - 1 - components[i];
+    return nComponents;
+}
+
 } // namespace
 } // namespace
 #endif
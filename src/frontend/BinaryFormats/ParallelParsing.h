@@ -0,0 +1,64 @@
+// Support for decoding large container tables (symbols, relocations) with more than one thread.
+#ifndef ROSE_ParallelParsing_H
+#define ROSE_ParallelParsing_H
+
+#include <featureTests.h>
+#ifdef ROSE_ENABLE_BINARY_ANALYSIS
+
+#include <Rose/CommandLine.h>
+#include <boost/thread.hpp>
+#include <Sawyer/Graph.h>
+#include <Sawyer/ThreadWorkers.h>
+
+#include <algorithm>
+
+namespace Rose {
+namespace BinaryAnalysis {
+
+/** Property: Number of table entries decoded by one parallel task.
+ *
+ *  Tables no larger than this are decoded by the calling thread. Smaller chunks let smaller tables be decoded in parallel,
+ *  at the cost of more tasks. The value must be positive, and the default is 16384. Changing it while a file is being
+ *  parsed affects only tables that are parsed later.
+ *
+ * @{ */
+size_t parallelParsingChunkSize();
+void parallelParsingChunkSize(size_t);
+/** @} */
+
+/** Invoke a functor on ranges of table entries, in parallel if possible.
+ *
+ *  The entries [0, nEntries) are divided into contiguous ranges that start at multiples of @p chunkSize, which is normally
+ *  the @ref parallelParsingChunkSize property read once by the caller, and the functor is called as
+ *  <code>functor(begin, end)</code> for each non-empty range. The number of threads comes from
+ *  the "--threads" command-line switch, or the hardware concurrency if that's zero. When only one thread is used the functor
+ *  is called once for the whole table. The functor is called concurrently, so it must write only to the entries in its range
+ *  and must not allocate IR nodes, read through the file's reference tracking, or otherwise modify the AST's shared state. */
+template<class Functor>
+void
+parseEntriesInParallel(size_t nEntries, size_t chunkSize, Functor functor) {
+    ASSERT_require(chunkSize > 0);
+    size_t nThreads = Rose::CommandLine::genericSwitchArgs.threads;
+    if (0 == nThreads)
+        nThreads = boost::thread::hardware_concurrency();
+    nThreads = std::max(nThreads, (size_t)1);
+
+    if (0 == nEntries) {
+        return;
+    } else if (1 == nThreads || nEntries <= chunkSize) {
+        functor((size_t)0, nEntries);
+    } else {
+        Sawyer::Container::Graph<size_t> tasks;
+        for (size_t begin = 0; begin < nEntries; begin += chunkSize)
+            tasks.insertVertex(begin);
+        Sawyer::workInParallel(tasks, nThreads, [nEntries, chunkSize, &functor](size_t, size_t begin) {
+            functor(begin, std::min(begin + chunkSize, nEntries));
+        });
+    }
+}
+
+} // namespace
+} // namespace
+
+#endif
+#endif